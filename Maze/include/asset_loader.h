@@ -0,0 +1,126 @@
+#ifndef ASSET_LOADER_H
+#define ASSET_LOADER_H
+
+#include <./include/mem_tracker.h>
+#include <glm/glm.hpp>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Pool simples de threads de trabalho (FIFO)
+// Com 0 threads os trabalhos correm logo na thread que os submete
+class ThreadPool
+{
+public:
+    explicit ThreadPool(unsigned int threadCount);
+    ~ThreadPool();
+
+    void submit(std::function<void()> job);
+    unsigned int size() const { return (unsigned int)workers.size(); }
+
+private:
+    void workerLoop();
+
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> jobs;
+    std::mutex mtx;
+    std::condition_variable cv;
+    bool stopping = false;
+};
+
+// Resultados da descodificação (só CPU, nada de GL aqui)
+struct DecodedImage
+{
+    std::string path;
+    int width = 0;
+    int height = 0;
+    int channels = 0; // canais em pixels (depois de forçar, se for o caso)
+    unsigned char *pixels = nullptr;
+
+    // Textura pré-comprimida (textures/cooked/*.ktx): formato GL + mipmaps já codificados
+    unsigned int compressedFormat = 0;
+    std::vector<TextureBytes> levels;
+
+    bool valid() const { return pixels != nullptr || compressedFormat != 0; }
+
+    DecodedImage() {}
+    ~DecodedImage();
+    DecodedImage(const DecodedImage &) = delete;
+    DecodedImage &operator=(const DecodedImage &) = delete;
+};
+
+struct DecodedMesh
+{
+    std::string path;
+    MeshVector<float> bufferData; // interleaved: pos(3) normal(3) uv(2)
+    MeshVector<glm::vec3> vertices;
+    MeshVector<glm::vec2> uvs;
+    MeshVector<glm::vec3> normals;
+};
+
+struct DecodedSound
+{
+    std::string path;
+    TaggedVector<short, MEM_AUDIO> samples;
+    int channels = 0;
+    int sampleRate = 0;
+};
+
+// Descodificadores (podem correr em qualquer thread)
+// DecodeImage usa a versão .ktx "cozinhada" (make textures) quando existe e o formato é suportado
+bool DecodeImage(const char *path, int desiredChannels, DecodedImage &out);
+void SetCookedTextureFormats(bool bc, bool etc2);
+bool DecodeMesh(const char *path, DecodedMesh &out);
+bool DecodeWav(const char *path, DecodedSound &out);
+
+int loadMeshFromFile(const char *obj_file, MeshVector<float> &bufferData, MeshVector<glm::vec3> &vertices, MeshVector<glm::vec2> &uvs, MeshVector<glm::vec3> &normals);
+
+// Carregamento assíncrono de assets:
+// a descodificação corre no pool e o callback (upload GL/AL) corre na thread que chama pump()/finish()
+class AssetLoader
+{
+public:
+    explicit AssetLoader(unsigned int workerCount);
+
+    void loadImage(const std::string &path, int desiredChannels, std::function<void(DecodedImage &)> onReady);
+    void loadMesh(const std::string &path, std::function<void(DecodedMesh &)> onReady);
+    // Trabalho genérico (ex.: abrir o device de áudio); onDone pode ser vazio
+    void run(const std::string &label, std::function<void()> work, std::function<void()> onDone);
+
+    // Corre os callbacks dos assets que já acabaram (não bloqueia)
+    int pump();
+    // Bloqueia até todos os pedidos terminarem, correndo os callbacks pelo caminho
+    void finish();
+
+    int pending() const { return inFlight.load(); }
+    unsigned int workers() const { return pool.size(); }
+
+    // Escreve no stdout o tempo de descodificação/upload de cada asset
+    bool logTimings = false;
+
+private:
+    struct Completed
+    {
+        std::string label;
+        double decodeMs;
+        std::function<void()> callback;
+    };
+
+    // decode corre no pool e devolve o callback a correr na thread do pump()
+    void submit(const std::string &label, std::function<std::function<void()>()> decode);
+
+    ThreadPool pool;
+    std::mutex doneMtx;
+    std::condition_variable doneCv;
+    std::deque<Completed> done;
+    std::atomic<int> inFlight;
+};
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef ASSET_MANAGER_H
+#define ASSET_MANAGER_H
+
+#include <./glad/include/glad/glad.h>
+#include <./include/asset_loader.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+// Upload (GL) de uma imagem já descodificada (ou pré-comprimida); devolve 0 se a imagem não for válida
+unsigned int UploadTexture(const DecodedImage &img, GLint wrap, bool mipmaps);
+// Estimativa da memória de GPU ocupada por essa imagem
+size_t TextureGpuBytes(const DecodedImage &img, bool mipmaps);
+
+// Handle para uma textura gerida (índice na tabela do AssetManager)
+typedef int TextureHandle;
+const TextureHandle INVALID_TEXTURE = -1;
+
+// Gestor de texturas com carregamento "lazy":
+// - texture() só regista o caminho; a imagem é descodificada/enviada para a GPU no primeiro get()
+// - acquire()/release() contam quem está a usar a textura (ex.: o ecrã actual)
+// - texturas sem referências ficam em cache e são libertadas por LRU quando se passa o orçamento de GPU
+class AssetManager
+{
+public:
+    explicit AssetManager(size_t gpuBudgetBytes);
+
+    TextureHandle texture(const std::string &path, GLint wrap = GL_CLAMP_TO_EDGE, bool mipmaps = false, int channels = 4);
+
+    void acquire(TextureHandle h);
+    void release(TextureHandle h);
+
+    // Id GL da textura (carrega-a se ainda não estiver residente)
+    GLuint get(TextureHandle h);
+
+    // Descodifica em background (upload no pump()/finish() do loader)
+    void prefetch(AssetLoader &loader, TextureHandle h);
+
+    // Liberta texturas sem referências (LRU primeiro) até caber no orçamento
+    void trim();
+    // Liberta tudo o que está na GPU (antes de destruir o contexto)
+    void clear();
+
+    size_t gpuBytes() const { return residentBytes; }
+    size_t gpuBudget() const { return budgetBytes; }
+    void setGpuBudget(size_t bytes) { budgetBytes = bytes; }
+    int residentCount() const;
+
+private:
+    enum EntryState
+    {
+        NOT_LOADED,
+        LOADING,
+        RESIDENT
+    };
+
+    struct Entry
+    {
+        std::string path;
+        GLint wrap;
+        bool mipmaps;
+        int channels;
+
+        EntryState loadState;
+        GLuint id;
+        size_t bytes;
+        int refCount;
+        unsigned long lastUse;
+    };
+
+    void upload(TextureHandle h, const DecodedImage &img);
+    void unload(Entry &e);
+
+    std::vector<Entry> entries;
+    std::map<std::string, TextureHandle> byPath;
+
+    size_t budgetBytes;
+    size_t residentBytes = 0;
+    unsigned long useCounter = 0;
+};
+
+#endif
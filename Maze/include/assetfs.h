@@ -0,0 +1,24 @@
+#ifndef ASSETFS_H
+#define ASSETFS_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+// Conteúdo de um asset: aponta para os bytes embutidos no executável (make embedded)
+// ou para uma cópia lida do disco
+struct AssetBlob
+{
+    const unsigned char *data = nullptr;
+    size_t size = 0;
+    std::vector<unsigned char> storage; // só usado quando vem do disco
+};
+
+// Lê "./shaders/ui.vs", "./textures/play.png", ... (caminhos relativos à pasta Maze/)
+bool ReadAsset(const char *path, AssetBlob &out);
+bool ReadAssetText(const char *path, std::string &out);
+
+// true no executável com os assets embutidos (não toca no disco)
+bool AssetsEmbedded();
+
+#endif
@@ -1,14 +1,13 @@
 #ifndef CAMERA_H
 #define CAMERA_H
 
-#include <./glad/include/glad/glad.h>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
 
 #include <vector>
 
-// Fixes camera's Y coordinate
-float FixedY;
+// Fixes camera's Y coordinate (defined in camera.cpp, so the header can be included anywhere)
+extern float FixedY;
 
 // Defines several possible options for camera movement. Used as abstraction to stay away from window-system specific input methods
 enum Camera_Movement
@@ -101,7 +100,7 @@ public:
     }
 
     // Processes input received from a mouse input system. Expects the offset value in both the x and y direction.
-    void ProcessMouseMovement(float xoffset, float yoffset, GLboolean constrainPitch = true)
+    void ProcessMouseMovement(float xoffset, float yoffset, bool constrainPitch = true)
     {
         xoffset *= MouseSensitivity;
         yoffset *= MouseSensitivity;
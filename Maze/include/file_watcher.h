@@ -0,0 +1,37 @@
+#ifndef FILE_WATCHER_H
+#define FILE_WATCHER_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Vigia uma pasta numa thread própria (inotify, só Linux) e junta os ficheiros alterados.
+// A thread de render chama takeChanged() uma vez por frame e trata dos caminhos devolvidos
+// (ex.: recompilar os shaders que os usam). Noutros sistemas start() devolve false.
+class FileWatcher
+{
+public:
+    FileWatcher() : changedFlag(false), stopping(false) {}
+    ~FileWatcher();
+
+    // dir relativo à pasta Maze/ (ex.: "./shaders")
+    bool start(const std::string &dir);
+    void stop();
+
+    // Caminhos ("./shaders/drunk.fs") alterados desde a última chamada, sem repetidos
+    bool takeChanged(std::vector<std::string> &out);
+
+private:
+    void watchLoop(int fd);
+
+    std::string dir;
+    std::thread worker;
+    std::mutex mtx;
+    std::vector<std::string> changed;
+    std::atomic<bool> changedFlag; // evita o lock quando não há nada
+    std::atomic<bool> stopping;
+};
+
+#endif
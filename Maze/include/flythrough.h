@@ -0,0 +1,61 @@
+#ifndef FLYTHROUGH_H
+#define FLYTHROUGH_H
+
+#include <./include/maze_grid.h>
+#include <glm/glm.hpp>
+
+#include <string>
+#include <vector>
+
+// Benchmark de render sem input gravado (MAZE_FLYTHROUGH=15,21,101,...): para cada tamanho
+// gera um labirinto com seed fixa, resolve-o e leva a câmara pelo caminho da solução a
+// velocidade constante por frame, desenhando todos os frames. Como a distância por frame
+// é fixa, duas corridas desenham exactamente as mesmas imagens.
+
+// Caminho mais curto (BFS) entre duas células livres (grid[z][x] == 0); vazio se não houver.
+// As estruturas do BFS vão para a arena do nível (libertadas com ele).
+bool SolveMaze(const MazeGrid &grid, LevelArena &arena, int startX, int startZ, int goalX, int goalZ,
+               std::vector<glm::vec3> &waypoints, float cellSize, float y);
+
+// Posição e direcção ao longo de uma linha poligonal, avançando uma distância de cada vez
+class PathFollower
+{
+public:
+    void reset(const std::vector<glm::vec3> &waypoints);
+    // false quando chega ao fim
+    bool advance(float distance);
+
+    glm::vec3 position() const { return pointAt(travelled); }
+    // para onde olhar: um pouco à frente no caminho (curvas suaves)
+    glm::vec3 front(float lookAhead) const;
+    float length() const { return total; }
+
+private:
+    glm::vec3 pointAt(float s) const;
+
+    std::vector<glm::vec3> points;
+    std::vector<float> distances; // distância acumulada até cada ponto
+    float total = 0.0f;
+    float travelled = 0.0f;
+};
+
+// Resultado de um tamanho. O sim preenche os dados do labirinto e o render os do frame.
+struct FlythroughRun
+{
+    int size = 0;
+    unsigned seed = 0;
+    size_t walls = 0;
+    size_t pathCells = 0;
+
+    // thread de render
+    std::vector<float> frameMs;
+    double drawCalls = 0.0; // somas por frame (a média vai para o relatório)
+    double triangles = 0.0;
+    std::vector<std::string> gpuPassNames;
+    std::vector<double> gpuPassMs; // somas por frame medido no GPU (lidos com atraso)
+    size_t gpuFrames = 0;
+};
+
+bool WriteFlythroughReport(const char *path, const std::vector<FlythroughRun> &runs);
+
+#endif
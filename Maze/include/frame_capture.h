@@ -0,0 +1,93 @@
+#ifndef FRAME_CAPTURE_H
+#define FRAME_CAPTURE_H
+
+#include <./glad/include/glad/glad.h>
+
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Captura de frames para disco sem parar o pipeline (MAZE_CAPTURE=<pasta>).
+//
+// Em cada frame capturado, antes do swap, o glReadPixels vai para um PBO de um anel de
+// CAPTURE_PBO_COUNT, com um fence; o PBO só é mapeado uns frames depois, quando o fence já
+// sinalizou, por isso a cópia GPU -> memória nunca bloqueia a thread de render. Os pixels
+// seguem para uma thread de escrita que os grava como PNG (frame_000000.png, ..., com o número
+// do frame desenhado) ou acrescenta a um único ficheiro raw (frames.rgba, RGBA8 com as linhas de
+// cima para baixo). Se o anel ou a fila de escrita estiverem cheios o frame é descartado, nunca
+// se espera; ao parar mostra-se quantos foram pedidos, descartados, perdidos no map e escritos.
+// Tudo excepto a thread de escrita só na thread que tem o contexto GL.
+const int CAPTURE_PBO_COUNT = 3;
+const size_t CAPTURE_QUEUE_MAX = 8; // frames à espera do disco
+
+class FrameCapture
+{
+public:
+    enum Format
+    {
+        PNG,
+        RAW
+    };
+
+    FrameCapture();
+    ~FrameCapture();
+
+    // cria a pasta e arranca a thread de escrita; every = capturar 1 em cada n frames
+    bool start(const std::string &dir, Format format, int every);
+    bool active() const { return running; }
+
+    // antes do swap: lê o framebuffer fbo (0 = back buffer da janela) de w x h
+    void captureFrame(GLuint fbo, int width, int height);
+    // espera pelas leituras pendentes, esvazia a fila e pára a thread (antes de destruir o contexto)
+    void stop();
+
+private:
+    struct Slot
+    {
+        GLuint pbo = 0;
+        GLsync fence = 0;
+        int width = 0, height = 0;
+        unsigned index = 0;
+    };
+
+    struct Image
+    {
+        unsigned index;
+        int width, height;
+        std::vector<unsigned char> pixels; // RGBA8, linhas de baixo para cima (como o GL)
+    };
+
+    // mapeia os PBOs cujo fence já sinalizou; com wait=true espera por todos
+    void collect(bool wait);
+    void writeLoop();
+    bool writeImage(const Image &image);
+
+    bool running;
+    std::string dir;
+    Format format;
+    int every;
+    unsigned frameCount; // frames vistos (para o every e o nome do ficheiro)
+    unsigned attempted;  // frames escolhidos para captura
+    unsigned dropped;    // anel ou fila cheios
+    unsigned mapFailed;  // glMapBufferRange falhou
+    unsigned written;    // escritos no disco (thread de escrita, com o mutex)
+    unsigned writeFailed;
+    int lastWidth, lastHeight;
+
+    Slot slots[CAPTURE_PBO_COUNT];
+    int nextSlot;
+
+    std::thread writer;
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::deque<Image> queue;
+    std::vector<std::vector<unsigned char>> spare; // buffers já escritos, para reutilizar
+    bool stopping;
+    FILE *rawFile;
+};
+
+#endif
@@ -0,0 +1,66 @@
+#ifndef FRAME_LATENCY_H
+#define FRAME_LATENCY_H
+
+#include <./glad/include/glad/glad.h>
+
+#include <cstddef>
+#include <deque>
+#include <vector>
+
+// Latência input -> imagem e limite de frames em voo (thread de render).
+//
+// Depois de cada swap fica um fence (glFenceSync) na fila do GPU; quando esse fence
+// sinaliza, o frame está acabado e registam-se:
+//   - input -> GPU acabou: desde o primeiro input que o frame reflecte
+//   - submit -> GPU acabou: desde o fim da submissão (antes do swap)
+// O "fim" é quando o fence é visto sinalizado (verificado no início e no fim de cada frame),
+// por isso é um limite superior com a resolução de um frame; sem contar o scanout do ecrã.
+// Antes de a thread de render dormir (render a pedido) chama-se flush(), senão o tempo parado
+// contava como latência do último frame.
+//
+// Com maxFramesInFlight > 0, beginFrame() espera (glClientWaitSync) que o frame mais antigo
+// acabe antes de começar outro: menos frames em fila = menos latência, menos throughput.
+class FrameLatency
+{
+public:
+    explicit FrameLatency(int maxFramesInFlight);
+
+    // antes de desenhar um frame
+    void beginFrame();
+    // depois do glfwSwapBuffers; inputTime 0 = o frame não tem input novo (tempos em glfwGetTime())
+    void endFrame(double inputTime, double submitTime);
+    // espera pelos frames ainda em voo e regista-os (antes de a thread ficar parada)
+    void flush();
+    // apaga os fences pendentes (antes de destruir o contexto)
+    void clear();
+
+    void printReport() const;
+
+    int maxFramesInFlight() const { return maxInFlight; }
+
+private:
+    struct InFlight
+    {
+        GLsync fence;
+        double inputTime;
+        double submitTime;
+    };
+
+    // recolhe os frames acabados; com wait=true espera pelo mais antigo
+    void collect(bool wait);
+    static void addSample(std::vector<float> &ring, size_t &next, float ms);
+
+    int maxInFlight;
+    std::deque<InFlight> frames;
+
+    // últimas amostras em ms (buffer circular)
+    std::vector<float> inputToDone;
+    std::vector<float> submitToDone;
+    size_t inputNext = 0;
+    size_t submitNext = 0;
+
+    double waitMs = 0.0; // tempo total bloqueado no limitador
+    unsigned long waits = 0;
+};
+
+#endif
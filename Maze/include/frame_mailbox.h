@@ -0,0 +1,85 @@
+#ifndef FRAME_MAILBOX_H
+#define FRAME_MAILBOX_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+
+// Troca de pacotes de frame entre uma thread que produz (simulação) e uma que consome (render),
+// sem locks e sem nenhuma das duas esperar pela outra.
+//
+// É um double buffer (o slot que se escreve e o que se lê) mais um slot "publicado" no meio:
+// publish() troca o slot escrito com o do meio e acquire() troca o do meio com o que se lê,
+// cada um com uma única operação atómica. O render fica sempre com o pacote mais recente;
+// pacotes intermédios que ele não chegou a ver são simplesmente substituídos.
+// Quando não há nada para desenhar (menus parados) o consumidor pode dormir em waitFresh();
+// só aí publish() toca no mutex, o caminho normal continua sem locks.
+template <typename T>
+class FrameMailbox
+{
+public:
+    FrameMailbox() : middle(1), back(2), front(0) {}
+
+    // Produtor: preencher o pacote todo (o slot tem dados antigos) e depois publish()
+    T &writeSlot() { return slots[back].value; }
+    void publish()
+    {
+        back = middle.exchange(back | FRESH) & INDEX;
+        if (waiting.load())
+        {
+            std::lock_guard<std::mutex> lock(wakeMtx);
+            wakeCv.notify_one();
+        }
+    }
+
+    // Consumidor: true se havia um pacote novo; read() devolve sempre o último obtido
+    bool acquire()
+    {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH))
+            return false;
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+    const T &read() const { return slots[front].value; }
+
+    // Consumidor: dorme até haver um pacote novo (ou passar o timeout); não o consome
+    bool waitFresh(std::chrono::milliseconds timeout)
+    {
+        std::unique_lock<std::mutex> lock(wakeMtx);
+        waiting.store(true);
+        bool fresh = wakeCv.wait_for(lock, timeout, [this]
+                                     { return (middle.load() & FRESH) != 0; });
+        waiting.store(false);
+        return fresh;
+    }
+
+    // Só com as duas threads paradas: devolve os slots ao estado inicial (larga o que os
+    // pacotes seguram, ex.: shared_ptr para dados do nível)
+    void clear()
+    {
+        for (int i = 0; i < 3; i++)
+            slots[i].value = T();
+    }
+
+private:
+    static const unsigned INDEX = 3u;
+    static const unsigned FRESH = 4u;
+
+    // cada slot na sua linha de cache
+    struct alignas(64) Slot
+    {
+        T value;
+    };
+
+    Slot slots[3];
+    alignas(64) std::atomic<unsigned> middle;
+    alignas(64) unsigned back;  // só o produtor
+    alignas(64) unsigned front; // só o consumidor
+
+    std::atomic<bool> waiting{false}; // consumidor em waitFresh()
+    std::mutex wakeMtx;
+    std::condition_variable wakeCv;
+};
+
+#endif
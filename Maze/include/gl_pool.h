@@ -0,0 +1,82 @@
+#ifndef GL_POOL_H
+#define GL_POOL_H
+
+#include <./glad/include/glad/glad.h>
+
+#include <cstddef>
+#include <vector>
+
+// Recursos GL que sobrevivem aos reinícios de nível: criar e apagar buffers e FBOs a cada
+// jogo novo obriga o driver a alocar (e às vezes a sincronizar) no pior momento, ao mudar de
+// dificuldade. Só na thread que tem o contexto GL.
+
+// Buffer reescrito no sítio: o primeiro upload cria-o com folga e os seguintes usam
+// glBufferSubData enquanto couberem, por isso o nome GL (e os VAOs que o apontam) não muda.
+class PooledBuffer
+{
+public:
+    PooledBuffer();
+
+    // devolve true se teve de (re)alocar a memória do buffer
+    bool upload(GLenum target, const void *data, size_t bytes);
+    void shutdown();
+
+    GLuint id() const { return buffer; }
+    size_t capacity() const { return capacityBytes; }
+    unsigned reallocations() const { return reallocCount; }
+
+private:
+    GLuint buffer;
+    size_t capacityBytes;
+    unsigned reallocCount;
+};
+
+// FBO com textura de cor (para amostrar num passe seguinte) e renderbuffer de profundidade
+struct RenderTarget
+{
+    GLuint fbo = 0;
+    GLuint color = 0;
+    GLuint depth = 0;
+    int width = 0;
+    int height = 0;
+    GLenum format = 0; // formato interno da cor (GL_RGB8, GL_RGBA8, ...)
+
+    bool valid() const { return fbo != 0; }
+};
+
+// Render targets reciclados por formato e tamanho: release() devolve o alvo ao pool em vez de
+// o apagar e acquire() dá um livre igual antes de criar outro. Ficam no máximo maxIdle livres
+// (os mais antigos são apagados, ex.: tamanhos de antes de um resize).
+class RenderTargetPool
+{
+public:
+    explicit RenderTargetPool(int maxIdle);
+
+    RenderTarget acquire(int width, int height, GLenum colorFormat);
+    void release(const RenderTarget &target);
+    // apaga todos, em uso ou não (antes de destruir o contexto)
+    void clear();
+
+    unsigned created() const { return createdCount; }
+    unsigned reused() const { return reusedCount; }
+
+private:
+    struct Entry
+    {
+        RenderTarget target;
+        bool inUse;
+        unsigned long lastUse;
+    };
+
+    static size_t targetBytes(const RenderTarget &t);
+    void destroy(Entry &e);
+    void trimIdle();
+
+    std::vector<Entry> entries;
+    int maxIdle;
+    unsigned long useCounter;
+    unsigned createdCount;
+    unsigned reusedCount;
+};
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef GL_STATE_H
+#define GL_STATE_H
+
+#include <./glad/include/glad/glad.h>
+
+// Contadores do frame (só a thread de render); o HUD mostra-os
+struct RenderStats
+{
+    unsigned drawCalls;
+    unsigned triangles;
+    unsigned uniformUploads;
+    unsigned stateChanges;        // binds que chegaram ao driver
+    unsigned stateChangesSkipped; // binds repetidos evitados pela cache
+};
+
+extern RenderStats gRenderStats;
+
+void ResetRenderStats();
+
+// Cache do estado GL mais usado no render: só chama o driver quando o valor muda.
+// Código que faça binds directamente (uploads, criação de FBOs, ...) tem de chamar
+// InvalidateGLState() depois.
+void GLUseProgram(GLuint program);
+void GLBindVertexArray(GLuint vao);
+void GLBindTexture2D(int unit, GLuint texture);
+void InvalidateGLState();
+
+// glDrawArrays(GL_TRIANGLES, ...) com contagem de draw calls / triângulos
+void GLDrawTriangles(GLint first, GLsizei vertexCount);
+
+inline void CountUniformUpload()
+{
+    gRenderStats.uniformUploads++;
+}
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef GPU_TIMER_H
+#define GPU_TIMER_H
+
+#include <./glad/include/glad/glad.h>
+
+// Tempo de GPU por passagem (paredes, chão, bêbado, UI, ...) com queries GL_TIMESTAMP.
+//
+// Cada frame usa um conjunto de queries de um anel de GPU_TIMER_FRAMES; os resultados só são
+// lidos quando esse conjunto volta a ser usado (GPU_TIMER_FRAMES frames depois), por isso
+// nunca se espera pelo GPU. Os tempos vão para passMs() (para o HUD) e para o profiler de CPU
+// (trace "GPU", já convertidos para o relógio do profiler).
+// Só na thread que tem o contexto GL.
+const int GPU_TIMER_FRAMES = 4;
+const int GPU_TIMER_MAX_PASSES = 8;
+
+class GpuTimer
+{
+public:
+    GpuTimer();
+
+    // cria as queries; false se o driver não tiver timestamps (fica tudo desligado)
+    bool init();
+    void shutdown();
+
+    // regista uma passagem (nome literal); devolve o índice a usar em begin()/end()
+    int addPass(const char *name);
+
+    void beginFrame();
+    void begin(int pass);
+    void end(int pass);
+
+    int passCount() const { return count; }
+    const char *passName(int pass) const { return names[pass]; }
+    // média móvel em ms (0 enquanto não houver resultados)
+    float passMs(int pass) const { return ms[pass]; }
+
+    // Valores em bruto do frame lido no último beginFrame(), o de há GPU_TIMER_FRAMES frames:
+    // ms da passagem nesse frame, -1 se ela não correu (ou o resultado não estava pronto)
+    float resolvedPassMs(int pass) const { return resolvedMs[pass]; }
+    // soma das passagens que correram nesse frame; -1 se não há resultado completo
+    float resolvedFrameMs() const { return resolvedTotal; }
+
+private:
+    void syncClock();
+
+    bool enabled;
+    int count;
+    int frame;
+    const char *names[GPU_TIMER_MAX_PASSES];
+    float ms[GPU_TIMER_MAX_PASSES];
+    float resolvedMs[GPU_TIMER_MAX_PASSES];
+    float resolvedTotal;
+
+    GLuint queries[GPU_TIMER_FRAMES][GPU_TIMER_MAX_PASSES][2]; // início / fim
+    bool issued[GPU_TIMER_FRAMES][GPU_TIMER_MAX_PASSES];
+
+    long long gpuToCpuNs; // relógio do GPU -> Profiler::nowNs()
+};
+
+// Mede uma passagem no âmbito actual
+class GpuPassScope
+{
+public:
+    GpuPassScope(GpuTimer &t, int p) : timer(t), pass(p) { timer.begin(pass); }
+    ~GpuPassScope() { timer.end(pass); }
+
+private:
+    GpuTimer &timer;
+    int pass;
+};
+
+#endif
@@ -0,0 +1,44 @@
+#ifndef HUD_H
+#define HUD_H
+
+#include <./glad/include/glad/glad.h>
+#include <./include/sprite_batch.h>
+
+const int HUD_GRAPH_FRAMES = 120;
+
+// HUD de desempenho: texto de uma fonte bitmap 5x7 (atlas gerado no arranque), rectângulos e
+// o gráfico dos tempos de frame. Tudo usa a mesma textura e vai para o SpriteBatch do UI, numa
+// camada própria; quem desenha é o flush() do batch.
+// Coordenadas em pixels, (0,0) no topo-esquerda (como o UI). Só na thread de render.
+class PerfHud
+{
+public:
+    PerfHud();
+
+    bool init(SpriteBatch &batch, int layer);
+    void shutdown();
+
+    // devolvem o x a seguir ao último carácter
+    float text(float x, float y, const char *s, unsigned int rgba);
+    float textf(float x, float y, unsigned int rgba, const char *fmt, ...);
+    void rect(float x, float y, float w, float h, unsigned int rgba);
+
+    void addFrameTime(float ms);
+    void frameTimeStats(float &avg, float &minMs, float &maxMs) const;
+    // barras dos últimos HUD_GRAPH_FRAMES frames (escala até maxMs)
+    void graph(float x, float y, float w, float h, float maxMs);
+
+    float lineHeight() const { return 9.0f * scale; }
+    float charWidth() const { return 6.0f * scale; }
+
+private:
+    SpriteBatch *batch;
+    int layer;
+    GLuint atlas;
+    float scale;
+
+    float frameTimes[HUD_GRAPH_FRAMES];
+    int frameTimeNext;
+};
+
+#endif
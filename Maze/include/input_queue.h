@@ -0,0 +1,69 @@
+#ifndef INPUT_QUEUE_H
+#define INPUT_QUEUE_H
+
+#include <atomic>
+
+// Evento de input tal como chegou dos callbacks GLFW (thread principal),
+// com o instante em que chegou para a simulação o aplicar no tick certo
+struct InputEvent
+{
+    enum Type
+    {
+        KEY,
+        CURSOR,
+        BUTTON,
+        SCROLL,
+        RESIZE,
+        REFRESH // janela exposta: redesenhar
+    };
+
+    Type type;
+    int code;    // tecla / botão
+    int action;  // GLFW_PRESS / GLFW_RELEASE
+    double x, y; // posição do cursor, scroll ou tamanho do framebuffer
+    double time; // glfwGetTime()
+};
+
+// Fila circular sem locks para um produtor e um consumidor (N potência de 2)
+template <typename T, unsigned N>
+class SpscRing
+{
+    static_assert((N & (N - 1)) == 0, "N tem de ser potência de 2");
+
+public:
+    SpscRing() : head(0), tail(0) {}
+
+    // produtor; false se a fila estiver cheia
+    bool push(const T &item)
+    {
+        unsigned h = head.load(std::memory_order_relaxed);
+        if (h - tail.load(std::memory_order_acquire) == N)
+            return false;
+        items[h & (N - 1)] = item;
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // consumidor: vê o mais antigo sem o tirar
+    bool peek(T &out) const
+    {
+        unsigned t = tail.load(std::memory_order_relaxed);
+        if (t == head.load(std::memory_order_acquire))
+            return false;
+        out = items[t & (N - 1)];
+        return true;
+    }
+
+    // consumidor: tira o mais antigo (depois de um peek com sucesso)
+    void pop()
+    {
+        tail.store(tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+private:
+    T items[N];
+    alignas(64) std::atomic<unsigned> head; // só o produtor escreve
+    alignas(64) std::atomic<unsigned> tail; // só o consumidor escreve
+};
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef KTX_H
+#define KTX_H
+
+#include <./include/mem_tracker.h>
+
+#include <string>
+#include <vector>
+
+// Formatos comprimidos usados nas texturas "cozinhadas" (valores GL)
+const unsigned int KTX_COMPRESSED_RGB_S3TC_DXT1 = 0x83F0;  // BC1
+const unsigned int KTX_COMPRESSED_RGBA_S3TC_DXT5 = 0x83F3; // BC3
+const unsigned int KTX_COMPRESSED_RGB8_ETC2 = 0x9274;      // ETC2 RGB
+const unsigned int KTX_BASE_RGB = 0x1907;
+const unsigned int KTX_BASE_RGBA = 0x1908;
+
+// Textura KTX (versão 1) só com formatos comprimidos: 1 face, sem arrays, N níveis de mipmap
+struct KtxTexture
+{
+    unsigned int glInternalFormat = 0;
+    unsigned int glBaseInternalFormat = 0;
+    int width = 0;
+    int height = 0;
+    std::vector<TextureBytes> levels; // levels[0] = tamanho original
+};
+
+bool LoadKTX(const char *path, KtxTexture &out);
+bool LoadKTXFromMemory(const unsigned char *data, size_t size, KtxTexture &out);
+bool SaveKTX(const char *path, const KtxTexture &tex);
+
+// "./textures/x.png" -> "./textures/cooked/x.<tag>.ktx"
+std::string CookedTexturePath(const std::string &pngPath, const char *tag);
+
+#endif
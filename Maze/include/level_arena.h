@@ -0,0 +1,76 @@
+#ifndef LEVEL_ARENA_H
+#define LEVEL_ARENA_H
+
+#include <./include/mem_tracker.h>
+
+#include <cstddef>
+#include <vector>
+
+// Arena do nível: um bloco grande reservado de uma vez e alocação por "bump" (avançar um
+// offset), sem free individual. Tudo o que pertence a um nível (grelha do labirinto, blocos a
+// desenhar, pilha da geração, estruturas do BFS) sai daqui e desaparece de uma vez, em O(1),
+// com reset() quando o nível acaba. Reiniciar o nível não toca no malloc nem fragmenta o heap.
+//
+// Se um nível não couber, a arena pede blocos extra ao sistema (a alocação nunca falha por
+// falta de espaço) e no reset() seguinte o bloco principal cresce para o pico visto, por isso
+// isto só acontece uma vez por tamanho de labirinto.
+// Só para tipos triviais (não há destrutores a correr) e uma thread de cada vez.
+class LevelArena
+{
+public:
+    explicit LevelArena(MemTag tag = MEM_MAZE);
+    ~LevelArena();
+    LevelArena(const LevelArena &) = delete;
+    LevelArena &operator=(const LevelArena &) = delete;
+
+    // garante pelo menos `bytes` no bloco principal; só com a arena vazia (depois de reset())
+    void reserve(size_t bytes);
+    void *allocate(size_t bytes, size_t align);
+    template <class T>
+    T *allocArray(size_t count)
+    {
+        return static_cast<T *>(allocate(count * sizeof(T), alignof(T)));
+    }
+    // liberta tudo o que foi alocado desde o último reset
+    void reset();
+
+    size_t used() const { return offset + overflowBytes; }
+    size_t capacity() const { return size; }
+    size_t peak() const { return peakBytes; }
+
+private:
+    char *block;
+    size_t size;
+    size_t offset;
+    struct Extra
+    {
+        char *data;
+        size_t bytes;
+    };
+    std::vector<Extra> overflow; // blocos extra deste nível (libertados no reset)
+    size_t overflowBytes;
+    size_t peakBytes;
+    MemTag tag;
+};
+
+// Array de tamanho fixo guardado numa arena (a memória é da arena, não do array)
+template <class T>
+struct ArenaArray
+{
+    T *items;
+    size_t count;
+
+    ArenaArray() : items(nullptr), count(0) {}
+    ArenaArray(T *p, size_t n) : items(p), count(n) {}
+
+    size_t size() const { return count; }
+    bool empty() const { return count == 0; }
+    T &operator[](size_t i) { return items[i]; }
+    const T &operator[](size_t i) const { return items[i]; }
+    T *begin() { return items; }
+    T *end() { return items + count; }
+    const T *begin() const { return items; }
+    const T *end() const { return items + count; }
+};
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef MAZE_GRID_H
+#define MAZE_GRID_H
+
+#include <./include/level_arena.h>
+#include <glm/glm.hpp>
+
+// Labirinto: grelha de MAZE_H x MAZE_W células, maze[z][x] = 1 (arbusto) ou 0 (caminho),
+// e as colisões do jogador com ela. Sem GL nem janela: também corre no benchmark (make bench).
+
+// Tamanho do labirinto
+//
+extern int MAZE_W;
+extern int MAZE_H;
+const float CELL_SIZE = 1.0f;
+
+// Grelha contígua (linha a linha) numa arena do nível: maze[z][x] como antes, sem um vector
+// por linha. A memória é da arena; clear() só esquece o ponteiro.
+class MazeGrid
+{
+public:
+    MazeGrid() : cells(nullptr), w(0), h(0) {}
+
+    void allocate(LevelArena &arena, int width, int height);
+    void clear()
+    {
+        cells = nullptr;
+        w = h = 0;
+    }
+
+    int *operator[](int z) { return cells + (size_t)z * w; }
+    const int *operator[](int z) const { return cells + (size_t)z * w; }
+    int width() const { return w; }
+    int height() const { return h; }
+    bool empty() const { return cells == nullptr; }
+
+private:
+    int *cells;
+    int w, h;
+};
+
+extern MazeGrid maze;
+
+// Bytes que um nível de w x h ocupa na arena (grelha, blocos, geração e BFS), com folga
+size_t LevelArenaBytes(int width, int height);
+
+// Raio do jogador para colisões
+//
+const float PLAYER_RADIUS = 0.10f;
+
+// usa rand(): srand(seed) antes dá sempre o mesmo labirinto
+// a grelha (e a pilha da geração) vão para a arena, normalmente acabada de fazer reset()
+void generateMaze(LevelArena &arena);
+void carveMaze(LevelArena &arena, int x, int z);
+
+bool checkCollision(glm::vec3 pos);
+
+#endif
@@ -0,0 +1,98 @@
+#ifndef MEM_TRACKER_H
+#define MEM_TRACKER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <new>
+#include <vector>
+
+// Contabilidade de memória por subsistema.
+//
+// Cada alocação é atribuída a uma tag: bytes vivos, pico e número de alocações/libertações,
+// com contadores atómicos (qualquer thread, sem locks). Os contentores do jogo usam o
+// TrackedAllocator (TaggedVector<T, tag>), os buffers do stb_image passam por MemTaggedMalloc
+// e a memória de GPU, que não vem do heap, é uma estimativa que o código GL soma e subtrai
+// com MemTrackAlloc/MemTrackFree. O HUD e a telemetria lêem MemStats(); no fim do programa
+// MemLeakReport() lista o que ficou por libertar.
+enum MemTag
+{
+    MEM_MAZE,    // arenas dos níveis (grelha, blocos, geração, BFS)
+    MEM_MESH,    // vértices (OBJ, chão)
+    MEM_TEXTURE, // pixels descodificados e níveis KTX
+    MEM_AUDIO,   // amostras dos WAV
+    MEM_UI,      // sprites e vértices do menu/HUD
+    MEM_GL,      // estimativa da memória de GPU (texturas, buffers, render targets)
+    MEM_TAG_COUNT
+};
+
+struct MemTagStats
+{
+    size_t current;
+    size_t peak;
+    uint64_t allocs;
+    uint64_t frees;
+};
+
+const char *MemTagName(MemTag tag);
+
+void MemTrackAlloc(MemTag tag, size_t bytes);
+void MemTrackFree(MemTag tag, size_t bytes);
+MemTagStats MemStats(MemTag tag);
+// soma das tags do heap (sem MEM_GL) e o seu pico
+size_t MemHeapCurrent();
+size_t MemHeapPeak();
+
+// malloc/realloc/free com a tag e o tamanho num cabeçalho (o free não sabe o tamanho)
+void *MemTaggedMalloc(MemTag tag, size_t bytes);
+void *MemTaggedRealloc(MemTag tag, void *p, size_t bytes);
+void MemTaggedFree(void *p);
+
+// Pico de cada tag e, para as que ainda têm memória viva, o aviso de fuga.
+// Chamar no fim, depois de libertar tudo; devolve o número de tags com fugas.
+int MemLeakReport(FILE *out);
+
+// Alocador para os contentores da STL que conta na tag
+template <class T, MemTag Tag>
+class TrackedAllocator
+{
+public:
+    typedef T value_type;
+
+    template <class U>
+    struct rebind
+    {
+        typedef TrackedAllocator<U, Tag> other;
+    };
+
+    TrackedAllocator() {}
+    template <class U>
+    TrackedAllocator(const TrackedAllocator<U, Tag> &) {}
+
+    T *allocate(size_t n)
+    {
+        T *p = static_cast<T *>(::operator new(n * sizeof(T)));
+        MemTrackAlloc(Tag, n * sizeof(T));
+        return p;
+    }
+
+    void deallocate(T *p, size_t n)
+    {
+        MemTrackFree(Tag, n * sizeof(T));
+        ::operator delete(p);
+    }
+};
+
+template <class T, class U, MemTag Tag>
+bool operator==(const TrackedAllocator<T, Tag> &, const TrackedAllocator<U, Tag> &) { return true; }
+template <class T, class U, MemTag Tag>
+bool operator!=(const TrackedAllocator<T, Tag> &, const TrackedAllocator<U, Tag> &) { return false; }
+
+template <class T, MemTag Tag>
+using TaggedVector = std::vector<T, TrackedAllocator<T, Tag>>;
+
+template <class T>
+using MeshVector = TaggedVector<T, MEM_MESH>;
+typedef TaggedVector<unsigned char, MEM_TEXTURE> TextureBytes;
+
+#endif
@@ -7,12 +7,13 @@
 #include <cstring>
 
 #include <glm/glm.hpp>
+#include "./mem_tracker.h"
 
 bool loadOBJ(
 	const char * path, 
-	std::vector<glm::vec3> & out_vertices, 
-	std::vector<glm::vec2> & out_uvs, 
-	std::vector<glm::vec3> & out_normals
+	MeshVector<glm::vec3> & out_vertices, 
+	MeshVector<glm::vec2> & out_uvs, 
+	MeshVector<glm::vec3> & out_normals
 );
 
 
@@ -0,0 +1,29 @@
+#ifndef OFFSCREEN_H
+#define OFFSCREEN_H
+
+#include <./glad/include/glad/glad.h>
+
+// Framebuffer de destino para o modo headless (MAZE_HEADLESS): cor RGBA8 + profundidade num
+// FBO próprio, que o render usa em vez do framebuffer da janela. Assim o pipeline desenha o
+// mesmo que num ecrã e a imagem pode ser lida (glReadPixels) mesmo sem janela visível.
+// Só na thread que tem o contexto GL.
+class OffscreenTarget
+{
+public:
+    OffscreenTarget();
+
+    // cria (ou redimensiona) os renderbuffers; false se o FBO ficar incompleto
+    bool resize(int width, int height);
+    void shutdown();
+
+    GLuint fbo() const { return framebuffer; }
+    int width() const { return w; }
+    int height() const { return h; }
+
+private:
+    GLuint framebuffer;
+    GLuint color, depth;
+    int w, h;
+};
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <cstdint>
+#include <string>
+
+// Profiler de CPU por zonas (RAII), barato o suficiente para ficar ligado em release:
+// cada zona são duas leituras do steady_clock e uma escrita no buffer circular da própria
+// thread (sem locks). dump() escreve tudo em JSON "trace_event" do Chrome
+// (abrir em chrome://tracing ou https://ui.perfetto.dev).
+//
+//   void f() { PROFILE_SCOPE("f"); ... }
+//
+// Os nomes têm de ser strings literais (só se guarda o ponteiro).
+
+namespace Profiler
+{
+    // Nome da thread no trace (chamar no início de cada thread)
+    void setThreadName(const char *name);
+
+    // MAZE_PROFILE=0 desliga a recolha
+    void setEnabled(bool on);
+    bool enabled();
+
+    uint64_t nowNs();
+    void record(const char *name, uint64_t startNs, uint64_t endNs);
+    // Zona de GPU (tempos já no relógio de nowNs()); aparece no trace como a thread "GPU".
+    // Só a thread de render a chama.
+    void recordGpu(const char *name, uint64_t startNs, uint64_t endNs);
+
+    // Escreve as zonas que ainda estão nos buffers; devolve false se não conseguir escrever
+    bool dump(const std::string &path);
+}
+
+class ProfileScope
+{
+public:
+    explicit ProfileScope(const char *zoneName) : name(zoneName), start(Profiler::enabled() ? Profiler::nowNs() : 0) {}
+    ~ProfileScope()
+    {
+        if (start)
+            Profiler::record(name, start, Profiler::nowNs());
+    }
+
+private:
+    const char *name;
+    uint64_t start;
+};
+
+#define PROFILE_CONCAT2(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT2(a, b)
+#define PROFILE_SCOPE(name) ProfileScope PROFILE_CONCAT(profileScope_, __LINE__)(name)
+
+#endif
@@ -0,0 +1,112 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <./include/input_queue.h>
+#include <glm/glm.hpp>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Gravação e replay de um jogo (MAZE_RECORD / MAZE_REPLAY).
+//
+// O ficheiro guarda a seed do labirinto, o modo e o estado inicial da câmara e das opções,
+// seguido dos eventos de input marcados com o tick de simulação em que foram aplicados
+// (e o instante, só informativo). Como a simulação corre a passo fixo, voltar a aplicar os
+// mesmos eventos nos mesmos ticks reproduz o mesmo jogo. De REPLAY_CAMERA_EVERY em
+// REPLAY_CAMERA_EVERY ticks fica também a posição da câmara, para medir o desvio no replay.
+//
+// Formato (little-endian, sem padding): cabeçalho e depois registos de tamanho fixo
+// com um byte de tipo à frente: evento (29 bytes), câmara (25 bytes), fim (5 bytes).
+const unsigned REPLAY_CAMERA_EVERY = 12;
+
+struct ReplayHeader
+{
+    unsigned seed = 0;
+    int mode = 2; // 1 easy, 2 normal, 3 hard
+    float yaw = -90.0f, pitch = 0.0f, zoom = 45.0f;
+    float mouseSense = 1.0f, arrowSense = 10.0f;
+    bool fixY = true;
+    bool flashlightOn = true;
+};
+
+struct ReplayCameraSample
+{
+    unsigned tick;
+    glm::vec3 pos;
+    float yaw, pitch;
+};
+
+class InputRecorder
+{
+public:
+    InputRecorder() : file(nullptr) {}
+    ~InputRecorder() { close(0); }
+
+    bool open(const char *path, const ReplayHeader &header);
+    bool isOpen() const { return file != nullptr; }
+
+    void event(unsigned tick, double time, const InputEvent &ev);
+    void camera(unsigned tick, const glm::vec3 &pos, float yaw, float pitch);
+    // escreve o registo de fim (último tick simulado) e fecha
+    void close(unsigned endTick);
+
+private:
+    FILE *file;
+};
+
+class InputReplay
+{
+public:
+    bool load(const char *path);
+
+    const ReplayHeader &header() const { return head; }
+    unsigned endTick() const { return lastTick; }
+    size_t eventCount() const { return events.size(); }
+
+    // eventos gravados para este tick, um de cada vez, pela ordem original
+    bool nextEvent(unsigned tick, InputEvent &ev);
+    // amostra de câmara gravada neste tick (se houver)
+    bool cameraAt(unsigned tick, ReplayCameraSample &out) const;
+
+private:
+    struct TimedEvent
+    {
+        unsigned tick;
+        InputEvent ev;
+    };
+
+    ReplayHeader head;
+    unsigned lastTick = 0;
+    std::vector<TimedEvent> events;
+    std::vector<ReplayCameraSample> cameras;
+    size_t nextIndex = 0;
+};
+
+// Resultado de um replay (estatísticas escritas em JSON no fim)
+struct ReplayResult
+{
+    std::string file;
+    ReplayHeader header;
+    bool unthrottled = false;
+    bool completed = false; // chegou ao fim da gravação
+    unsigned ticks = 0;
+    double wallSeconds = 0.0;
+    float maxCameraDrift = 0.0f; // maior distância à posição gravada
+    std::vector<float> frameMs;  // swap a swap, só a thread de render escreve
+};
+
+bool WriteReplayReport(const char *path, const ReplayResult &result);
+
+// Distribuição dos tempos de frame (ms); também usada pelo benchmark de fly-through
+struct FrameTimeSummary
+{
+    size_t frames = 0;
+    float mean = 0.0f, p50 = 0.0f, p95 = 0.0f, p99 = 0.0f, max = 0.0f;
+};
+
+FrameTimeSummary SummarizeFrameTimes(const std::vector<float> &frameMs);
+// {"mean": .., "p50": .., "p95": .., "p99": .., "max": ..}
+void WriteFrameTimeJson(FILE *f, const FrameTimeSummary &s);
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef SPRITE_BATCH_H
+#define SPRITE_BATCH_H
+
+#include <./glad/include/glad/glad.h>
+#include <./include/mem_tracker.h>
+#include <./include/shader_m.h>
+#include <glm/glm.hpp>
+
+#include <vector>
+
+// texturas diferentes que cabem num draw (uma por unidade, escolhida por vértice no shader)
+const int SPRITE_BATCH_TEXTURES = 8;
+
+// cor RGBA (um byte por canal, pela ordem da memória)
+#define SPRITE_RGBA(r, g, b, a) ((unsigned int)(r) | ((unsigned int)(g) << 8) | ((unsigned int)(b) << 16) | ((unsigned int)(a) << 24))
+#define SPRITE_WHITE SPRITE_RGBA(255, 255, 255, 255)
+
+// Sprites 2D (menu, HUD): os quads acumulam-se durante o frame e flush() desenha-os todos
+// com o menor número de draws possível. São ordenados por camada e, dentro da camada, por
+// textura; até SPRITE_BATCH_TEXTURES texturas diferentes vão no mesmo draw.
+// Sprites da mesma camada não se devem sobrepor (a ordem entre eles não é garantida).
+// Coordenadas em pixels, (0,0) no topo-esquerda. Só na thread de render.
+class SpriteBatch
+{
+public:
+    SpriteBatch();
+
+    bool init();
+    void shutdown();
+
+    // (u0,v0) no canto de cima à esquerda, (u1,v1) no de baixo à direita
+    void add(float x, float y, float w, float h, GLuint tex, float u0, float v0, float u1, float v1,
+             unsigned int rgba = SPRITE_WHITE, int layer = 0);
+    // imagem inteira (as texturas do stb_image são carregadas com flip vertical)
+    void addImage(float x, float y, float w, float h, GLuint tex, int layer = 0);
+
+    // envia os vértices (um upload) e desenha; devolve o número de draws
+    int flush(Shader &shader, const glm::mat4 &proj);
+
+private:
+    struct Sprite
+    {
+        float x, y, w, h;
+        float u0, v0, u1, v1;
+        unsigned int rgba;
+        GLuint tex;
+        int layer;
+    };
+
+    struct SpriteVertex
+    {
+        float x, y;
+        float u, v;
+        unsigned int rgba;
+        float slot; // unidade de textura (0..SPRITE_BATCH_TEXTURES-1)
+    };
+
+    struct DrawRange
+    {
+        GLint first;
+        GLsizei count;
+        GLuint textures[SPRITE_BATCH_TEXTURES];
+        int textureCount;
+    };
+
+    GLuint vao, vbo;
+    size_t vboBytes;
+    TaggedVector<Sprite, MEM_UI> sprites;
+    TaggedVector<SpriteVertex, MEM_UI> verts;
+    TaggedVector<DrawRange, MEM_UI> ranges;
+};
+
+#endif
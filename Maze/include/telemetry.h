@@ -0,0 +1,102 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Histograma de tempos ao estilo HDR: buckets log-lineares em microsegundos, exactos até
+// 128 us e depois com 64 sub-buckets por potência de 2 (erro relativo < 1.6%), até ~19 horas.
+// Memória fixa (~16 KB), registar é O(1) e os percentis não precisam de guardar amostras.
+class HdrHistogram
+{
+public:
+    HdrHistogram();
+
+    void record(uint64_t us);
+    void reset();
+    void add(const HdrHistogram &other);
+
+    uint64_t count() const { return total; }
+    uint64_t max() const { return maxUs; }
+    double mean() const { return total ? (double)sumUs / total : 0.0; }
+    // menor valor com pelo menos p% das amostras abaixo ou iguais (p em 0..100)
+    uint64_t percentile(double p) const;
+
+private:
+    static int bucketOf(uint64_t us);
+    static uint64_t bucketTop(int bucket); // maior valor que cai no bucket
+
+    std::vector<uint64_t> counts;
+    uint64_t total;
+    uint64_t sumUs;
+    uint64_t maxUs;
+};
+
+// Telemetria de frames (MAZE_TELEMETRY / MAZE_TELEMETRY_SOCKET).
+//
+// A thread de render chama recordFrame() depois de cada swap com os quatro tempos do frame:
+// CPU (do início do frame até à submissão), GPU (soma das passagens do frame que o GpuTimer
+// acabou de resolver, alguns frames atrás), intervalo entre swaps e espera no swap. Cada
+// métrica tem um histograma da janela actual e um acumulado desde o início.
+// Uma thread própria, a cada `period` segundos, junta a janela numa linha de percentis
+// (p50/p90/p99/p99.9/max) no ficheiro de log, CSV ou JSON por linha conforme a extensão, e roda
+// o ficheiro (log.1, log.2, ...) quando passa maxBytes. Com um socket Unix, cada ligação recebe
+// os acumulados em texto no formato do Prometheus (com cabeçalho HTTP se o pedido for um GET,
+// para funcionar com `curl --unix-socket`).
+class Telemetry
+{
+public:
+    enum Metric
+    {
+        CPU,
+        GPU,
+        INTERVAL,
+        SWAP,
+        METRIC_COUNT
+    };
+
+    Telemetry();
+    ~Telemetry();
+
+    // logPath e socketPath podem ser vazios (cada um desliga a sua saída)
+    bool start(const std::string &logPath, const std::string &socketPath, double period, size_t maxBytes);
+    void stop();
+    bool active() const { return running; }
+
+    // tempos em ms; gpuMs < 0 = sem tempo de GPU neste frame
+    void recordFrame(float cpuMs, float gpuMs, float intervalMs, float swapMs);
+
+private:
+    void exportLoop();
+    void serveLoop();
+    void writeSummary(double now);
+    void rotate();
+    std::string prometheusText();
+
+    bool running;
+    std::string logPath, socketPath;
+    bool json;
+    double period;
+    size_t maxBytes;
+    FILE *log;
+    int listenFd;
+
+    std::mutex mtx; // histogramas
+    HdrHistogram window[METRIC_COUNT];
+    HdrHistogram cumulative[METRIC_COUNT];
+    uint64_t frames;
+
+    std::atomic<bool> stopping;
+    std::mutex wakeMtx;
+    std::condition_variable wakeCv;
+    std::thread exporter;
+    std::thread server;
+};
+
+#endif
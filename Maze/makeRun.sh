@@ -1,6 +1,7 @@
 #If you are using this, every file path in main.cpp must be relative to this file and not to main.cpp
 
 make
+make textures
 
 EXEC="./bin/maze"
 
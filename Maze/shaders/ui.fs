@@ -1,9 +1,27 @@
 #version 330 core
 in vec2 vUV;
+in vec4 vColor;
+flat in int vSlot;
 out vec4 FragColor;
 
-uniform sampler2D uTex;
+// uma textura por unidade (SpriteBatch); no 3.30 só se indexa o array com constantes
+uniform sampler2D uTex[8];
 
 void main() {
-    FragColor = texture(uTex, vUV);
+    // derivadas fora dos ramos (o mipmap não depende do sprite vizinho)
+    vec2 dx = dFdx(vUV);
+    vec2 dy = dFdy(vUV);
+
+    vec4 c;
+    switch (vSlot) {
+    case 0: c = textureGrad(uTex[0], vUV, dx, dy); break;
+    case 1: c = textureGrad(uTex[1], vUV, dx, dy); break;
+    case 2: c = textureGrad(uTex[2], vUV, dx, dy); break;
+    case 3: c = textureGrad(uTex[3], vUV, dx, dy); break;
+    case 4: c = textureGrad(uTex[4], vUV, dx, dy); break;
+    case 5: c = textureGrad(uTex[5], vUV, dx, dy); break;
+    case 6: c = textureGrad(uTex[6], vUV, dx, dy); break;
+    default: c = textureGrad(uTex[7], vUV, dx, dy); break;
+    }
+    FragColor = vColor * c;
 }
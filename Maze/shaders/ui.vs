@@ -1,11 +1,17 @@
 #version 330 core
 layout (location = 0) in vec2 aPos;
 layout (location = 1) in vec2 aUV;
+layout (location = 2) in vec4 aColor;
+layout (location = 3) in float aSlot;
 
 out vec2 vUV;
+out vec4 vColor;
+flat out int vSlot;
 uniform mat4 uProj;
 
 void main() {
     vUV = aUV;
+    vColor = aColor;
+    vSlot = int(aSlot + 0.5);
     gl_Position = uProj * vec4(aPos.xy, 0.0, 1.0);
 }
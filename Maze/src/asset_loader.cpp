@@ -0,0 +1,357 @@
+#include <./include/asset_loader.h>
+#include <./include/assetfs.h>
+#include <./include/ktx.h>
+#include <./include/profiler.h>
+#include <./include/objloader.hpp>
+#include <./include/stb_image.h>
+
+#include <sndfile.h>
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+// ===================== ThreadPool =====================
+
+ThreadPool::ThreadPool(unsigned int threadCount)
+{
+    for (unsigned int i = 0; i < threadCount; i++)
+        workers.push_back(std::thread(&ThreadPool::workerLoop, this));
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+    }
+    cv.notify_all();
+
+    for (size_t i = 0; i < workers.size(); i++)
+        workers[i].join();
+}
+
+void ThreadPool::submit(std::function<void()> job)
+{
+    // sem threads: corre já (modo sequencial)
+    if (workers.empty())
+    {
+        job();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        jobs.push_back(std::move(job));
+    }
+    cv.notify_one();
+}
+
+void ThreadPool::workerLoop()
+{
+    Profiler::setThreadName("asset worker");
+
+    while (true)
+    {
+        std::function<void()> job;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            cv.wait(lock, [this]
+                    { return stopping || !jobs.empty(); });
+
+            if (stopping && jobs.empty())
+                return;
+
+            job = std::move(jobs.front());
+            jobs.pop_front();
+        }
+        PROFILE_SCOPE("asset job");
+        job();
+    }
+}
+
+// ===================== Descodificadores =====================
+
+DecodedImage::~DecodedImage()
+{
+    if (pixels)
+        stbi_image_free(pixels);
+}
+
+// Formatos comprimidos que o driver aceita (definidos uma vez no arranque, antes de haver trabalhos)
+static bool gCookedBC = false;
+static bool gCookedETC2 = false;
+
+void SetCookedTextureFormats(bool bc, bool etc2)
+{
+    gCookedBC = bc;
+    gCookedETC2 = etc2;
+}
+
+static bool LoadCookedImage(const char *path, DecodedImage &out)
+{
+    AssetBlob blob;
+    bool found = (gCookedBC && ReadAsset(CookedTexturePath(path, "bc").c_str(), blob)) ||
+                 (gCookedETC2 && ReadAsset(CookedTexturePath(path, "etc2").c_str(), blob));
+
+    KtxTexture ktx;
+    if (!found || !LoadKTXFromMemory(blob.data, blob.size, ktx) || ktx.levels.empty())
+        return false;
+
+    out.width = ktx.width;
+    out.height = ktx.height;
+    out.channels = ktx.glBaseInternalFormat == KTX_BASE_RGBA ? 4 : 3;
+    out.compressedFormat = ktx.glInternalFormat;
+    out.levels.swap(ktx.levels);
+    return true;
+}
+
+bool DecodeImage(const char *path, int desiredChannels, DecodedImage &out)
+{
+    out.path = path;
+    if (LoadCookedImage(path, out))
+        return true;
+
+    // Flip (Blender compatibility) - versão por thread, o flag global não é seguro entre workers
+    stbi_set_flip_vertically_on_load_thread(true);
+
+    AssetBlob blob;
+    if (!ReadAsset(path, blob))
+        return false;
+
+    int fileChannels = 0;
+    out.pixels = stbi_load_from_memory(blob.data, (int)blob.size, &out.width, &out.height, &fileChannels, desiredChannels);
+    out.channels = desiredChannels ? desiredChannels : fileChannels;
+
+    return out.pixels != nullptr;
+}
+
+int loadMeshFromFile(const char *obj_file, MeshVector<float> &bufferData, MeshVector<glm::vec3> &vertices, MeshVector<glm::vec2> &uvs, MeshVector<glm::vec3> &normals)
+{
+    if (!loadOBJ(obj_file, vertices, uvs, normals))
+    {
+        std::cout << "Failed to load OBJ file!" << std::endl;
+        return -1;
+    }
+
+    bufferData.reserve(bufferData.size() + vertices.size() * 8);
+
+    // Store data in the buffer
+    for (size_t i = 0; i < vertices.size(); ++i)
+    {
+        // Add vertex position
+        bufferData.push_back(vertices[i].x);
+        bufferData.push_back(vertices[i].y);
+        bufferData.push_back(vertices[i].z);
+
+        // Add normals (if they exist)
+        if (i < normals.size())
+        {
+            bufferData.push_back(normals[i].x);
+            bufferData.push_back(normals[i].y);
+            bufferData.push_back(normals[i].z);
+        }
+        else
+        {
+            bufferData.push_back(0.0f);
+            bufferData.push_back(0.0f);
+            bufferData.push_back(0.0f);
+        }
+
+        // Add UV coordinates
+        if (i < uvs.size())
+        {
+            bufferData.push_back(uvs[i].x);
+            bufferData.push_back(uvs[i].y);
+        }
+        else
+        {
+            bufferData.push_back(0.0f);
+            bufferData.push_back(0.0f);
+        }
+    }
+
+    return 0;
+}
+
+bool DecodeMesh(const char *path, DecodedMesh &out)
+{
+    out.path = path;
+    return loadMeshFromFile(path, out.bufferData, out.vertices, out.uvs, out.normals) == 0;
+}
+
+// libsndfile a ler de memória (o WAV pode estar embutido no executável)
+struct MemoryFile
+{
+    const unsigned char *data;
+    sf_count_t size;
+    sf_count_t pos;
+};
+
+static sf_count_t MemGetLength(void *user)
+{
+    return ((MemoryFile *)user)->size;
+}
+
+static sf_count_t MemSeek(sf_count_t offset, int whence, void *user)
+{
+    MemoryFile *mf = (MemoryFile *)user;
+    sf_count_t pos = offset;
+    if (whence == SEEK_CUR)
+        pos = mf->pos + offset;
+    else if (whence == SEEK_END)
+        pos = mf->size + offset;
+
+    if (pos < 0 || pos > mf->size)
+        return -1;
+    mf->pos = pos;
+    return pos;
+}
+
+static sf_count_t MemRead(void *ptr, sf_count_t count, void *user)
+{
+    MemoryFile *mf = (MemoryFile *)user;
+    if (count > mf->size - mf->pos)
+        count = mf->size - mf->pos;
+
+    memcpy(ptr, mf->data + mf->pos, (size_t)count);
+    mf->pos += count;
+    return count;
+}
+
+static sf_count_t MemWrite(const void *, sf_count_t, void *)
+{
+    return 0;
+}
+
+static sf_count_t MemTell(void *user)
+{
+    return ((MemoryFile *)user)->pos;
+}
+
+bool DecodeWav(const char *path, DecodedSound &out)
+{
+    out.path = path;
+
+    AssetBlob blob;
+    SNDFILE *sndfile = nullptr;
+    SF_INFO sfinfo;
+    SF_VIRTUAL_IO io = {MemGetLength, MemSeek, MemRead, MemWrite, MemTell};
+    MemoryFile mf = {nullptr, 0, 0};
+
+    if (ReadAsset(path, blob))
+    {
+        mf.data = blob.data;
+        mf.size = (sf_count_t)blob.size;
+        sfinfo.format = 0;
+        sndfile = sf_open_virtual(&io, SFM_READ, &sfinfo, &mf);
+    }
+    if (!sndfile)
+    {
+        std::cout << "Erro a abrir som: " << path << "\n";
+        return false;
+    }
+
+    out.samples.resize(sfinfo.frames * sfinfo.channels);
+    sf_readf_short(sndfile, out.samples.data(), sfinfo.frames);
+    sf_close(sndfile);
+
+    out.channels = sfinfo.channels;
+    out.sampleRate = sfinfo.samplerate;
+    return true;
+}
+
+// ===================== AssetLoader =====================
+
+typedef std::chrono::steady_clock LoaderClock;
+
+static double MsSince(LoaderClock::time_point t0)
+{
+    return std::chrono::duration<double, std::milli>(LoaderClock::now() - t0).count();
+}
+
+AssetLoader::AssetLoader(unsigned int workerCount) : pool(workerCount), inFlight(0)
+{
+}
+
+void AssetLoader::submit(const std::string &label, std::function<std::function<void()>()> decode)
+{
+    inFlight++;
+    pool.submit([this, label, decode]
+                {
+        LoaderClock::time_point t0 = LoaderClock::now();
+        Completed c;
+        c.label = label;
+        c.callback = decode();
+        c.decodeMs = MsSince(t0);
+        {
+            std::lock_guard<std::mutex> lock(doneMtx);
+            done.push_back(std::move(c));
+        }
+        doneCv.notify_one(); });
+}
+
+void AssetLoader::loadImage(const std::string &path, int desiredChannels, std::function<void(DecodedImage &)> onReady)
+{
+    submit(path, [path, desiredChannels, onReady]() -> std::function<void()>
+           {
+        std::shared_ptr<DecodedImage> img(new DecodedImage());
+        if (!DecodeImage(path.c_str(), desiredChannels, *img))
+            std::cout << "Falha a carregar textura: " << path << "\n";
+        return [img, onReady]
+        { onReady(*img); }; });
+}
+
+void AssetLoader::loadMesh(const std::string &path, std::function<void(DecodedMesh &)> onReady)
+{
+    submit(path, [path, onReady]() -> std::function<void()>
+           {
+        std::shared_ptr<DecodedMesh> mesh(new DecodedMesh());
+        DecodeMesh(path.c_str(), *mesh);
+        return [mesh, onReady]
+        { onReady(*mesh); }; });
+}
+
+void AssetLoader::run(const std::string &label, std::function<void()> work, std::function<void()> onDone)
+{
+    submit(label, [work, onDone]() -> std::function<void()>
+           {
+        work();
+        return onDone; });
+}
+
+int AssetLoader::pump()
+{
+    std::deque<Completed> ready;
+    {
+        std::lock_guard<std::mutex> lock(doneMtx);
+        ready.swap(done);
+    }
+
+    for (size_t i = 0; i < ready.size(); i++)
+    {
+        LoaderClock::time_point t0 = LoaderClock::now();
+        if (ready[i].callback)
+            ready[i].callback();
+
+        if (logTimings)
+            std::cout << "[startup]   decode " << ready[i].decodeMs << " ms, upload " << MsSince(t0)
+                      << " ms  " << ready[i].label << "\n";
+        inFlight--;
+    }
+    return (int)ready.size();
+}
+
+void AssetLoader::finish()
+{
+    while (inFlight.load() > 0)
+    {
+        {
+            std::unique_lock<std::mutex> lock(doneMtx);
+            doneCv.wait(lock, [this]
+                        { return !done.empty(); });
+        }
+        pump();
+    }
+}
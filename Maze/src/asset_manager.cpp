@@ -0,0 +1,209 @@
+#include <./include/asset_manager.h>
+#include <./include/gl_state.h>
+
+#include <iostream>
+
+unsigned int UploadTexture(const DecodedImage &img, GLint wrap, bool mipmaps)
+{
+    if (!img.valid())
+        return 0;
+
+    GLuint tex;
+    glGenTextures(1, &tex);
+    glBindTexture(GL_TEXTURE_2D, tex);
+
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    if (img.compressedFormat)
+    {
+        // mipmaps já gerados offline: só upload dos níveis
+        int levelCount = mipmaps ? (int)img.levels.size() : 1;
+        int w = img.width, h = img.height;
+        for (int level = 0; level < levelCount; level++)
+        {
+            glCompressedTexImage2D(GL_TEXTURE_2D, level, img.compressedFormat, w, h, 0,
+                                   (GLsizei)img.levels[level].size(), img.levels[level].data());
+            w = w > 1 ? w / 2 : 1;
+            h = h > 1 ? h / 2 : 1;
+        }
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, levelCount - 1);
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, levelCount > 1 ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+    }
+    else
+    {
+        GLenum format = GL_RGBA;
+        if (img.channels == 1)
+            format = GL_RED;
+        else if (img.channels == 3)
+            format = GL_RGB;
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, mipmaps ? GL_LINEAR_MIPMAP_LINEAR : GL_LINEAR);
+        glTexImage2D(GL_TEXTURE_2D, 0, format, img.width, img.height, 0, format, GL_UNSIGNED_BYTE, img.pixels);
+        if (mipmaps)
+            glGenerateMipmap(GL_TEXTURE_2D);
+    }
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    InvalidateGLState(); // bind feito fora da cache
+    return tex;
+}
+
+size_t TextureGpuBytes(const DecodedImage &img, bool mipmaps)
+{
+    if (img.compressedFormat)
+    {
+        size_t bytes = 0;
+        size_t levelCount = mipmaps ? img.levels.size() : 1;
+        for (size_t i = 0; i < levelCount && i < img.levels.size(); i++)
+            bytes += img.levels[i].size();
+        return bytes;
+    }
+
+    size_t bytes = (size_t)img.width * img.height * img.channels;
+    if (mipmaps)
+        bytes += bytes / 3;
+    return bytes;
+}
+
+AssetManager::AssetManager(size_t gpuBudgetBytes) : budgetBytes(gpuBudgetBytes)
+{
+}
+
+TextureHandle AssetManager::texture(const std::string &path, GLint wrap, bool mipmaps, int channels)
+{
+    std::map<std::string, TextureHandle>::iterator it = byPath.find(path);
+    if (it != byPath.end())
+        return it->second;
+
+    Entry e;
+    e.path = path;
+    e.wrap = wrap;
+    e.mipmaps = mipmaps;
+    e.channels = channels;
+    e.loadState = NOT_LOADED;
+    e.id = 0;
+    e.bytes = 0;
+    e.refCount = 0;
+    e.lastUse = 0;
+
+    TextureHandle h = (TextureHandle)entries.size();
+    entries.push_back(e);
+    byPath[path] = h;
+    return h;
+}
+
+void AssetManager::acquire(TextureHandle h)
+{
+    if (h == INVALID_TEXTURE)
+        return;
+    entries[h].refCount++;
+}
+
+void AssetManager::release(TextureHandle h)
+{
+    if (h == INVALID_TEXTURE)
+        return;
+    if (entries[h].refCount > 0)
+        entries[h].refCount--;
+}
+
+GLuint AssetManager::get(TextureHandle h)
+{
+    if (h == INVALID_TEXTURE)
+        return 0;
+
+    Entry &e = entries[h];
+    e.lastUse = ++useCounter;
+
+    if (e.loadState == NOT_LOADED)
+    {
+        DecodedImage img;
+        if (!DecodeImage(e.path.c_str(), e.channels, img))
+            std::cout << "Falha a carregar textura: " << e.path << "\n";
+        upload(h, img);
+    }
+
+    // LOADING: ainda no loader, desenha sem textura este frame
+    return entries[h].id;
+}
+
+void AssetManager::prefetch(AssetLoader &loader, TextureHandle h)
+{
+    if (h == INVALID_TEXTURE || entries[h].loadState != NOT_LOADED)
+        return;
+
+    entries[h].loadState = LOADING;
+    loader.loadImage(entries[h].path, entries[h].channels, [this, h](DecodedImage &img)
+                     { upload(h, img); });
+}
+
+void AssetManager::upload(TextureHandle h, const DecodedImage &img)
+{
+    Entry &e = entries[h];
+
+    e.id = UploadTexture(img, e.wrap, e.mipmaps);
+    e.bytes = TextureGpuBytes(img, e.mipmaps);
+
+    // mesmo que falhe fica "residente" (id 0) para não tentar descodificar em todos os frames
+    e.loadState = RESIDENT;
+    residentBytes += e.bytes;
+    MemTrackAlloc(MEM_GL, e.bytes);
+
+    trim();
+}
+
+void AssetManager::unload(Entry &e)
+{
+    if (e.id)
+        glDeleteTextures(1, &e.id);
+    residentBytes -= e.bytes;
+    MemTrackFree(MEM_GL, e.bytes);
+
+    e.id = 0;
+    e.bytes = 0;
+    e.loadState = NOT_LOADED;
+}
+
+void AssetManager::trim()
+{
+    while (residentBytes > budgetBytes)
+    {
+        Entry *victim = nullptr;
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            Entry &e = entries[i];
+            if (e.loadState != RESIDENT || e.refCount > 0)
+                continue;
+            if (!victim || e.lastUse < victim->lastUse)
+                victim = &e;
+        }
+
+        // tudo o que está residente está em uso -> deixa passar o orçamento
+        if (!victim)
+            return;
+
+        unload(*victim);
+    }
+}
+
+void AssetManager::clear()
+{
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        if (entries[i].loadState == RESIDENT)
+            unload(entries[i]);
+    }
+}
+
+int AssetManager::residentCount() const
+{
+    int n = 0;
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        if (entries[i].loadState == RESIDENT)
+            n++;
+    }
+    return n;
+}
@@ -0,0 +1,80 @@
+#include <./include/assetfs.h>
+
+#include <cstdio>
+#include <cstring>
+
+#ifdef MAZE_EMBED_ASSETS
+
+// Tabela gerada por tools/embed (obj/embedded_assets.cpp)
+struct EmbeddedAsset
+{
+    const char *path;
+    const unsigned char *data;
+    size_t size;
+};
+
+extern const EmbeddedAsset gEmbeddedAssets[];
+extern const size_t gEmbeddedAssetCount;
+
+#endif
+
+// "./textures/x.png" e "textures/x.png" são o mesmo asset
+static const char *NormalizePath(const char *path)
+{
+    while (path[0] == '.' && path[1] == '/')
+        path += 2;
+    return path;
+}
+
+bool AssetsEmbedded()
+{
+#ifdef MAZE_EMBED_ASSETS
+    return true;
+#else
+    return false;
+#endif
+}
+
+bool ReadAsset(const char *path, AssetBlob &out)
+{
+    path = NormalizePath(path);
+
+#ifdef MAZE_EMBED_ASSETS
+    for (size_t i = 0; i < gEmbeddedAssetCount; i++)
+    {
+        if (strcmp(gEmbeddedAssets[i].path, path) == 0)
+        {
+            out.data = gEmbeddedAssets[i].data;
+            out.size = gEmbeddedAssets[i].size;
+            return true;
+        }
+    }
+    return false;
+#else
+    FILE *file = fopen(path, "rb");
+    if (!file)
+        return false;
+
+    fseek(file, 0, SEEK_END);
+    long len = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    out.storage.resize(len > 0 ? (size_t)len : 0);
+    bool ok = len >= 0 && fread(out.storage.data(), 1, out.storage.size(), file) == out.storage.size();
+    fclose(file);
+
+    out.data = out.storage.data();
+    out.size = out.storage.size();
+    return ok;
+#endif
+}
+
+bool ReadAssetText(const char *path, std::string &out)
+{
+    AssetBlob blob;
+    if (!ReadAsset(path, blob))
+        return false;
+
+    out.assign((const char *)blob.data, blob.size);
+    return true;
+}
@@ -0,0 +1,3 @@
+#include <./include/camera.h>
+
+float FixedY;
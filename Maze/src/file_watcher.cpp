@@ -0,0 +1,106 @@
+#include <./include/file_watcher.h>
+
+#include <algorithm>
+#include <iostream>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+FileWatcher::~FileWatcher()
+{
+    stop();
+}
+
+bool FileWatcher::start(const std::string &watchDir)
+{
+#ifdef __linux__
+    if (worker.joinable())
+        return true;
+
+    int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (fd < 0)
+        return false;
+
+    // IN_CLOSE_WRITE: gravação normal; IN_MOVED_TO: editores que gravam num temporário e fazem rename
+    if (inotify_add_watch(fd, watchDir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0)
+    {
+        close(fd);
+        return false;
+    }
+
+    dir = watchDir;
+    stopping = false;
+    worker = std::thread(&FileWatcher::watchLoop, this, fd);
+    return true;
+#else
+    (void)watchDir;
+    return false;
+#endif
+}
+
+void FileWatcher::stop()
+{
+    stopping = true;
+    if (worker.joinable())
+        worker.join();
+}
+
+bool FileWatcher::takeChanged(std::vector<std::string> &out)
+{
+    out.clear();
+    if (!changedFlag.load(std::memory_order_acquire))
+        return false;
+
+    std::lock_guard<std::mutex> lock(mtx);
+    out.swap(changed);
+    changedFlag.store(false, std::memory_order_release);
+    return !out.empty();
+}
+
+#ifdef __linux__
+
+void FileWatcher::watchLoop(int fd)
+{
+    // alinhado como struct inotify_event (man 7 inotify)
+    alignas(struct inotify_event) char buf[4096];
+
+    while (!stopping)
+    {
+        // acorda de vez em quando para ver o stopping
+        struct pollfd pfd = {fd, POLLIN, 0};
+        if (poll(&pfd, 1, 200) <= 0)
+            continue;
+
+        ssize_t len = read(fd, buf, sizeof(buf));
+        if (len <= 0)
+            continue;
+
+        std::lock_guard<std::mutex> lock(mtx);
+        for (char *p = buf; p < buf + len;)
+        {
+            struct inotify_event *ev = (struct inotify_event *)p;
+            p += sizeof(struct inotify_event) + ev->len;
+
+            if (ev->len == 0 || ev->name[0] == '.')
+                continue; // ficheiros temporários dos editores (.x.swp, ...)
+
+            std::string path = dir + "/" + ev->name;
+            if (std::find(changed.begin(), changed.end(), path) == changed.end())
+                changed.push_back(path);
+        }
+        changedFlag.store(!changed.empty(), std::memory_order_release);
+    }
+
+    close(fd);
+}
+
+#else
+
+void FileWatcher::watchLoop(int)
+{
+}
+
+#endif
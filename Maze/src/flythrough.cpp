@@ -0,0 +1,157 @@
+#include <./include/flythrough.h>
+#include <./include/replay.h>
+
+#include <cstdio>
+
+bool SolveMaze(const MazeGrid &grid, LevelArena &arena, int startX, int startZ, int goalX, int goalZ,
+               std::vector<glm::vec3> &waypoints, float cellSize, float y)
+{
+    waypoints.clear();
+    int h = grid.height();
+    int w = grid.width();
+    if (startX < 0 || startZ < 0 || startX >= w || startZ >= h || grid[startZ][startX] != 0)
+        return false;
+
+    // de onde se chegou a cada célula (-1 = ainda não visitada); cada célula entra uma vez
+    // na fila, por isso a fila é um array de w * h com um índice de leitura e um de escrita
+    size_t cells = (size_t)w * h;
+    int *from = arena.allocArray<int>(cells);
+    int *open = arena.allocArray<int>(cells);
+    for (size_t i = 0; i < cells; i++)
+        from[i] = -1;
+    size_t head = 0, tail = 0;
+    int start = startZ * w + startX;
+    int goal = goalZ * w + goalX;
+    from[start] = start;
+    open[tail++] = start;
+
+    static const int dx[4] = {1, -1, 0, 0};
+    static const int dz[4] = {0, 0, 1, -1};
+
+    while (head < tail && from[goal] < 0)
+    {
+        int c = open[head++];
+        int cx = c % w, cz = c / w;
+        for (int d = 0; d < 4; d++)
+        {
+            int nx = cx + dx[d], nz = cz + dz[d];
+            if (nx < 0 || nz < 0 || nx >= w || nz >= h || grid[nz][nx] != 0)
+                continue;
+            int n = nz * w + nx;
+            if (from[n] >= 0)
+                continue;
+            from[n] = c;
+            open[tail++] = n;
+        }
+    }
+    if (from[goal] < 0)
+        return false;
+
+    // do fim para o início, depois inverter; o centro de cada célula
+    for (int c = goal;; c = from[c])
+    {
+        waypoints.push_back(glm::vec3((c % w + 0.5f) * cellSize, y, (c / w + 0.5f) * cellSize));
+        if (c == start)
+            break;
+    }
+    for (size_t i = 0, j = waypoints.size() - 1; i < j; i++, j--)
+        std::swap(waypoints[i], waypoints[j]);
+    return true;
+}
+
+void PathFollower::reset(const std::vector<glm::vec3> &waypoints)
+{
+    points = waypoints;
+    distances.assign(points.size(), 0.0f);
+    for (size_t i = 1; i < points.size(); i++)
+        distances[i] = distances[i - 1] + glm::length(points[i] - points[i - 1]);
+    total = points.empty() ? 0.0f : distances.back();
+    travelled = 0.0f;
+}
+
+bool PathFollower::advance(float distance)
+{
+    travelled += distance;
+    if (travelled < total)
+        return true;
+    travelled = total;
+    return false;
+}
+
+glm::vec3 PathFollower::pointAt(float s) const
+{
+    if (points.empty())
+        return glm::vec3(0.0f);
+    if (s <= 0.0f)
+        return points.front();
+    if (s >= total)
+        return points.back();
+
+    // segmento que contém s
+    size_t lo = 0, hi = distances.size() - 1;
+    while (hi - lo > 1)
+    {
+        size_t mid = (lo + hi) / 2;
+        if (distances[mid] <= s)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    float seg = distances[hi] - distances[lo];
+    float t = seg > 0.0f ? (s - distances[lo]) / seg : 0.0f;
+    return glm::mix(points[lo], points[hi], t);
+}
+
+glm::vec3 PathFollower::front(float lookAhead) const
+{
+    glm::vec3 here = pointAt(travelled);
+    glm::vec3 ahead = pointAt(travelled + lookAhead);
+    if (glm::length(ahead - here) < 1e-4f && points.size() > 1)
+    {
+        // no fim: a direcção do último segmento
+        here = points[points.size() - 2];
+        ahead = points.back();
+    }
+    glm::vec3 dir = ahead - here;
+    dir.y = 0.0f;
+    return glm::length(dir) > 1e-4f ? glm::normalize(dir) : glm::vec3(1.0f, 0.0f, 0.0f);
+}
+
+bool WriteFlythroughReport(const char *path, const std::vector<FlythroughRun> &runs)
+{
+    FILE *f = fopen(path, "w");
+    if (!f)
+        return false;
+
+    fprintf(f, "{\n  \"flythrough\": [\n");
+    for (size_t r = 0; r < runs.size(); r++)
+    {
+        const FlythroughRun &run = runs[r];
+        FrameTimeSummary s = SummarizeFrameTimes(run.frameMs);
+        double frames = s.frames ? (double)s.frames : 1.0;
+
+        printf("[flythrough] %5d x %-5d %8zu blocos  %4zu frames  média %8.2f  p95 %8.2f  max %8.2f ms  %9.0f draws\n",
+               run.size, run.size, run.walls, s.frames, s.mean, s.p95, s.max, run.drawCalls / frames);
+
+        fprintf(f, "    {\n");
+        fprintf(f, "      \"size\": %d,\n", run.size);
+        fprintf(f, "      \"seed\": %u,\n", run.seed);
+        fprintf(f, "      \"walls\": %zu,\n", run.walls);
+        fprintf(f, "      \"path_cells\": %zu,\n", run.pathCells);
+        fprintf(f, "      \"frames\": %zu,\n", s.frames);
+        fprintf(f, "      \"frame_ms\": ");
+        WriteFrameTimeJson(f, s);
+        fprintf(f, ",\n");
+        fprintf(f, "      \"draw_calls\": %.1f,\n", run.drawCalls / frames);
+        fprintf(f, "      \"triangles\": %.1f,\n", run.triangles / frames);
+        fprintf(f, "      \"gpu_ms\": {");
+        for (size_t p = 0; p < run.gpuPassNames.size(); p++)
+            fprintf(f, "%s\"%s\": %.4f", p ? ", " : "", run.gpuPassNames[p].c_str(),
+                    run.gpuPassMs[p] / (run.gpuFrames ? (double)run.gpuFrames : 1.0));
+        fprintf(f, "}\n");
+        fprintf(f, "    }%s\n", r + 1 < runs.size() ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+    return true;
+}
@@ -0,0 +1,354 @@
+#include <./include/frame_capture.h>
+
+#include <cstring>
+#include <iostream>
+#include <stdint.h>
+#include <sys/stat.h>
+
+// ===================== PNG =====================
+//
+// PNG mínimo sem dependências: RGBA8, filtro 0 e deflate em blocos "stored" (sem compressão).
+// Os ficheiros ficam do tamanho dos pixels, mas a escrita custa pouco mais que um memcpy e a
+// thread de escrita acompanha o render; para vídeo usa-se o formato raw.
+
+static uint32_t Crc32(uint32_t crc, const unsigned char *data, size_t n)
+{
+    static uint32_t table[256];
+    static bool ready = false;
+    if (!ready)
+    {
+        for (uint32_t i = 0; i < 256; i++)
+        {
+            uint32_t c = i;
+            for (int k = 0; k < 8; k++)
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            table[i] = c;
+        }
+        ready = true;
+    }
+    crc = ~crc;
+    for (size_t i = 0; i < n; i++)
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    return ~crc;
+}
+
+static void PutBE32(std::vector<unsigned char> &out, uint32_t v)
+{
+    out.push_back((unsigned char)(v >> 24));
+    out.push_back((unsigned char)(v >> 16));
+    out.push_back((unsigned char)(v >> 8));
+    out.push_back((unsigned char)v);
+}
+
+static void WriteChunk(FILE *f, const char *type, const std::vector<unsigned char> &data)
+{
+    std::vector<unsigned char> head;
+    PutBE32(head, (uint32_t)data.size());
+    head.insert(head.end(), type, type + 4);
+    fwrite(head.data(), 1, head.size(), f);
+    if (!data.empty())
+        fwrite(data.data(), 1, data.size(), f);
+
+    uint32_t crc = Crc32(0, (const unsigned char *)type, 4);
+    crc = Crc32(crc, data.data(), data.size());
+    std::vector<unsigned char> tail;
+    PutBE32(tail, crc);
+    fwrite(tail.data(), 1, tail.size(), f);
+}
+
+// pixels RGBA8 com as linhas de baixo para cima (glReadPixels): o PNG fica direito
+static bool WritePng(const char *path, int width, int height, const unsigned char *pixels)
+{
+    FILE *f = fopen(path, "wb");
+    if (!f)
+        return false;
+
+    static const unsigned char signature[8] = {137, 'P', 'N', 'G', 13, 10, 26, 10};
+    fwrite(signature, 1, 8, f);
+
+    std::vector<unsigned char> ihdr;
+    PutBE32(ihdr, (uint32_t)width);
+    PutBE32(ihdr, (uint32_t)height);
+    ihdr.push_back(8); // bits por canal
+    ihdr.push_back(6); // RGBA
+    ihdr.push_back(0);
+    ihdr.push_back(0);
+    ihdr.push_back(0);
+    WriteChunk(f, "IHDR", ihdr);
+
+    // dados do zlib: cada linha é um byte de filtro + os pixels, partidos em blocos de até 64 KB
+    size_t stride = (size_t)width * 4;
+    size_t raw = (stride + 1) * height;
+    std::vector<unsigned char> idat;
+    idat.reserve(raw + raw / 65535 * 5 + 16);
+    idat.push_back(0x78); // zlib, janela de 32 KB
+    idat.push_back(0x01);
+
+    uint32_t a = 1, b = 0; // adler32
+    size_t left = raw, blockLeft = 0;
+    for (int y = 0; y < height; y++)
+    {
+        const unsigned char *line = pixels + (size_t)(height - 1 - y) * stride;
+        for (size_t i = 0; i <= stride; i++)
+        {
+            if (blockLeft == 0)
+            {
+                blockLeft = left < 65535 ? left : 65535;
+                idat.push_back(left == blockLeft ? 1 : 0); // último bloco?
+                idat.push_back((unsigned char)blockLeft);
+                idat.push_back((unsigned char)(blockLeft >> 8));
+                idat.push_back((unsigned char)~blockLeft);
+                idat.push_back((unsigned char)(~blockLeft >> 8));
+            }
+            unsigned char c = i == 0 ? 0 : line[i - 1]; // filtro 0 (nenhum)
+            idat.push_back(c);
+            a = (a + c) % 65521;
+            b = (b + a) % 65521;
+            blockLeft--;
+            left--;
+        }
+    }
+    PutBE32(idat, (b << 16) | a);
+    WriteChunk(f, "IDAT", idat);
+    WriteChunk(f, "IEND", std::vector<unsigned char>());
+
+    bool ok = !ferror(f);
+    fclose(f);
+    return ok;
+}
+
+// ===================== FrameCapture =====================
+
+FrameCapture::FrameCapture()
+    : running(false), format(PNG), every(1), frameCount(0), attempted(0), dropped(0), mapFailed(0), written(0),
+      writeFailed(0), lastWidth(0), lastHeight(0), nextSlot(0),
+      stopping(false), rawFile(nullptr)
+{
+}
+
+FrameCapture::~FrameCapture()
+{
+    // o contexto GL já não existe: só a thread de escrita
+    if (writer.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        cv.notify_one();
+        writer.join();
+    }
+}
+
+bool FrameCapture::start(const std::string &captureDir, Format captureFormat, int captureEvery)
+{
+    if (running)
+        return true;
+
+    dir = captureDir;
+    mkdir(dir.c_str(), 0755);
+    format = captureFormat;
+    every = captureEvery > 0 ? captureEvery : 1;
+
+    if (format == RAW)
+    {
+        std::string path = dir + "/frames.rgba";
+        rawFile = fopen(path.c_str(), "wb");
+        if (!rawFile)
+            return false;
+    }
+
+    for (int i = 0; i < CAPTURE_PBO_COUNT; i++)
+        glGenBuffers(1, &slots[i].pbo);
+
+    stopping = false;
+    writer = std::thread(&FrameCapture::writeLoop, this);
+    running = true;
+    return true;
+}
+
+void FrameCapture::captureFrame(GLuint fbo, int width, int height)
+{
+    if (!running)
+        return;
+
+    collect(false);
+    unsigned frame = frameCount++;
+    if (frame % every != 0)
+        return;
+    attempted++;
+
+    Slot &s = slots[nextSlot];
+    if (s.fence)
+    {
+        // o GPU ainda não acabou a leitura de há CAPTURE_PBO_COUNT capturas: descartar
+        dropped++;
+        return;
+    }
+    nextSlot = (nextSlot + 1) % CAPTURE_PBO_COUNT;
+
+    size_t bytes = (size_t)width * height * 4;
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, s.pbo);
+    if (s.width != width || s.height != height)
+        glBufferData(GL_PIXEL_PACK_BUFFER, bytes, nullptr, GL_STREAM_READ);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, fbo);
+    glReadBuffer(fbo ? GL_COLOR_ATTACHMENT0 : GL_BACK);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr); // para o PBO: não espera
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    s.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    s.width = lastWidth = width;
+    s.height = lastHeight = height;
+    s.index = frame;
+}
+
+void FrameCapture::collect(bool wait)
+{
+    // pela ordem de captura, a começar no mais antigo
+    for (int n = 0; n < CAPTURE_PBO_COUNT; n++)
+    {
+        Slot &s = slots[(nextSlot + n) % CAPTURE_PBO_COUNT];
+        if (!s.fence)
+            continue;
+
+        GLenum r = glClientWaitSync(s.fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, wait ? 1000000000ull : 0);
+        if (r != GL_ALREADY_SIGNALED && r != GL_CONDITION_SATISFIED)
+        {
+            if (wait)
+                continue;
+            break; // os seguintes são mais recentes
+        }
+        glDeleteSync(s.fence);
+        s.fence = 0;
+
+        Image image;
+        image.index = s.index;
+        image.width = s.width;
+        image.height = s.height;
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            if (queue.size() >= CAPTURE_QUEUE_MAX)
+            {
+                dropped++; // o disco não acompanha
+                continue;
+            }
+            if (!spare.empty())
+            {
+                image.pixels.swap(spare.back());
+                spare.pop_back();
+            }
+        }
+
+        size_t bytes = (size_t)s.width * s.height * 4;
+        image.pixels.resize(bytes);
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, s.pbo);
+        void *mapped = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, bytes, GL_MAP_READ_BIT);
+        if (mapped)
+        {
+            memcpy(image.pixels.data(), mapped, bytes);
+            glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+        }
+        glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+        if (!mapped)
+        {
+            mapFailed++;
+            std::lock_guard<std::mutex> lock(mtx);
+            spare.push_back(std::move(image.pixels));
+            continue;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            queue.push_back(std::move(image));
+        }
+        cv.notify_one();
+    }
+}
+
+void FrameCapture::stop()
+{
+    if (!running)
+        return;
+
+    collect(true);
+    for (int i = 0; i < CAPTURE_PBO_COUNT; i++)
+    {
+        if (slots[i].fence)
+            glDeleteSync(slots[i].fence);
+        glDeleteBuffers(1, &slots[i].pbo);
+        slots[i] = Slot();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        stopping = true;
+    }
+    cv.notify_one();
+    writer.join();
+    running = false;
+
+    if (rawFile)
+    {
+        fclose(rawFile);
+        rawFile = nullptr;
+    }
+
+    // a thread de escrita já terminou: os contadores dela podem ler-se sem o mutex
+    std::cout << "[capture] " << written << " de " << attempted << " frames escritos em " << dir << " ("
+              << dropped << " descartados, " << mapFailed << " falhas no map, " << writeFailed
+              << " erros de escrita)\n";
+    if (format == RAW && written)
+        std::cout << "[capture] ffmpeg -f rawvideo -pix_fmt rgba -s " << lastWidth << "x" << lastHeight << " -i " << dir
+                  << "/frames.rgba out.mp4\n";
+}
+
+void FrameCapture::writeLoop()
+{
+    for (;;)
+    {
+        Image image;
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            cv.wait(lock, [this]
+                    { return stopping || !queue.empty(); });
+            if (queue.empty())
+                return; // stopping e já está tudo escrito
+            image = std::move(queue.front());
+            queue.pop_front();
+        }
+
+        bool ok = writeImage(image);
+
+        std::lock_guard<std::mutex> lock(mtx);
+        if (ok)
+            written++;
+        else
+            writeFailed++;
+        spare.push_back(std::move(image.pixels));
+    }
+}
+
+bool FrameCapture::writeImage(const Image &image)
+{
+    if (format == RAW)
+    {
+        // de cima para baixo, como espera o ffmpeg (-f rawvideo)
+        size_t stride = (size_t)image.width * 4;
+        bool ok = true;
+        for (int y = image.height - 1; y >= 0; y--)
+            ok = fwrite(image.pixels.data() + y * stride, 1, stride, rawFile) == stride && ok;
+        return ok;
+    }
+
+    char name[32];
+    snprintf(name, sizeof(name), "/frame_%06u.png", image.index);
+    std::string path = dir + name;
+    if (!WritePng(path.c_str(), image.width, image.height, image.pixels.data()))
+    {
+        std::cout << "[capture] erro a escrever " << path << "\n";
+        return false;
+    }
+    return true;
+}
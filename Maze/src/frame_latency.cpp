@@ -0,0 +1,133 @@
+#include <./include/frame_latency.h>
+#include <GLFW/glfw3.h>
+
+#include <algorithm>
+#include <cstdio>
+
+static const size_t MAX_SAMPLES = 4096;
+
+FrameLatency::FrameLatency(int maxFramesInFlight) : maxInFlight(maxFramesInFlight)
+{
+    inputToDone.reserve(MAX_SAMPLES);
+    submitToDone.reserve(MAX_SAMPLES);
+}
+
+void FrameLatency::addSample(std::vector<float> &ring, size_t &next, float ms)
+{
+    if (ring.size() < MAX_SAMPLES)
+        ring.push_back(ms);
+    else
+        ring[next] = ms;
+    next = (next + 1) % MAX_SAMPLES;
+}
+
+void FrameLatency::collect(bool wait)
+{
+    while (!frames.empty())
+    {
+        InFlight &f = frames.front();
+
+        GLenum status;
+        if (wait)
+        {
+            double t0 = glfwGetTime();
+            // timeout em ns; 100 ms chega para nunca ficar preso se o driver se portar mal
+            status = glClientWaitSync(f.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 100000000ull);
+            waitMs += (glfwGetTime() - t0) * 1000.0;
+            waits++;
+            wait = false;
+        }
+        else
+        {
+            status = glClientWaitSync(f.fence, 0, 0);
+        }
+
+        if (status == GL_TIMEOUT_EXPIRED)
+            return;
+
+        double done = glfwGetTime();
+        if (status != GL_WAIT_FAILED)
+        {
+            if (f.inputTime > 0.0)
+                addSample(inputToDone, inputNext, (float)((done - f.inputTime) * 1000.0));
+            addSample(submitToDone, submitNext, (float)((done - f.submitTime) * 1000.0));
+        }
+
+        glDeleteSync(f.fence);
+        frames.pop_front();
+    }
+}
+
+void FrameLatency::beginFrame()
+{
+    collect(false);
+    if (maxInFlight > 0 && (int)frames.size() >= maxInFlight)
+        collect(true);
+}
+
+void FrameLatency::endFrame(double inputTime, double submitTime)
+{
+    InFlight f;
+    f.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    f.inputTime = inputTime;
+    f.submitTime = submitTime;
+    frames.push_back(f);
+
+    collect(false);
+}
+
+void FrameLatency::flush()
+{
+    while (!frames.empty())
+    {
+        InFlight &f = frames.front();
+        // não conta para o limitador: é só para o fence não ficar por ver durante a pausa
+        GLenum status = glClientWaitSync(f.fence, GL_SYNC_FLUSH_COMMANDS_BIT, 100000000ull);
+        double done = glfwGetTime();
+        // se nem assim acabou, a amostra já não diz nada: descarta-se
+        if (status == GL_ALREADY_SIGNALED || status == GL_CONDITION_SATISFIED)
+        {
+            if (f.inputTime > 0.0)
+                addSample(inputToDone, inputNext, (float)((done - f.inputTime) * 1000.0));
+            addSample(submitToDone, submitNext, (float)((done - f.submitTime) * 1000.0));
+        }
+
+        glDeleteSync(f.fence);
+        frames.pop_front();
+    }
+}
+
+void FrameLatency::clear()
+{
+    for (size_t i = 0; i < frames.size(); i++)
+        glDeleteSync(frames[i].fence);
+    frames.clear();
+}
+
+static void PrintPercentiles(const char *label, const std::vector<float> &samples)
+{
+    if (samples.empty())
+    {
+        printf("  %-22s sem amostras\n", label);
+        return;
+    }
+
+    std::vector<float> sorted(samples);
+    std::sort(sorted.begin(), sorted.end());
+    size_t n = sorted.size();
+
+    printf("  %-22s p50 %6.2f  p90 %6.2f  p99 %6.2f  max %6.2f ms  (%zu amostras)\n", label,
+           sorted[n * 50 / 100], sorted[n * 90 / 100], sorted[n * 99 / 100], sorted[n - 1], n);
+}
+
+void FrameLatency::printReport() const
+{
+    if (maxInFlight > 0)
+        printf("[latência] máximo de frames em voo: %d\n", maxInFlight);
+    else
+        printf("[latência] frames em voo sem limite\n");
+    PrintPercentiles("input -> GPU acabou", inputToDone);
+    PrintPercentiles("submit -> GPU acabou", submitToDone);
+    if (waits)
+        printf("  limitador: %lu esperas, %.2f ms em média\n", waits, waitMs / waits);
+}
@@ -0,0 +1,155 @@
+#include <./include/gl_pool.h>
+#include <./include/mem_tracker.h>
+
+#include <iostream>
+
+// ===================== PooledBuffer =====================
+
+// folga ao (re)alocar: metade do pedido, arredondado a 4 KB
+static size_t WithHeadroom(size_t bytes)
+{
+    size_t grown = bytes + bytes / 2;
+    return (grown + 4095) & ~(size_t)4095;
+}
+
+PooledBuffer::PooledBuffer() : buffer(0), capacityBytes(0), reallocCount(0)
+{
+}
+
+bool PooledBuffer::upload(GLenum target, const void *data, size_t bytes)
+{
+    if (!buffer)
+        glGenBuffers(1, &buffer);
+    glBindBuffer(target, buffer);
+
+    bool grew = bytes > capacityBytes;
+    if (grew)
+    {
+        MemTrackFree(MEM_GL, capacityBytes);
+        capacityBytes = WithHeadroom(bytes);
+        glBufferData(target, capacityBytes, nullptr, GL_STATIC_DRAW);
+        MemTrackAlloc(MEM_GL, capacityBytes);
+        reallocCount++;
+    }
+    if (bytes)
+        glBufferSubData(target, 0, bytes, data);
+    return grew;
+}
+
+void PooledBuffer::shutdown()
+{
+    if (buffer)
+        glDeleteBuffers(1, &buffer);
+    MemTrackFree(MEM_GL, capacityBytes);
+    buffer = 0;
+    capacityBytes = 0;
+}
+
+// ===================== RenderTargetPool =====================
+
+RenderTargetPool::RenderTargetPool(int maxIdle)
+    : maxIdle(maxIdle), useCounter(0), createdCount(0), reusedCount(0)
+{
+}
+
+size_t RenderTargetPool::targetBytes(const RenderTarget &t)
+{
+    size_t colorBytes = t.format == GL_RGBA8 ? 4 : 3;
+    return (size_t)t.width * t.height * (colorBytes + 4); // + DEPTH24_STENCIL8
+}
+
+RenderTarget RenderTargetPool::acquire(int width, int height, GLenum colorFormat)
+{
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        Entry &e = entries[i];
+        if (!e.inUse && e.target.width == width && e.target.height == height && e.target.format == colorFormat)
+        {
+            e.inUse = true;
+            e.lastUse = ++useCounter;
+            reusedCount++;
+            return e.target;
+        }
+    }
+
+    Entry e;
+    e.target.width = width;
+    e.target.height = height;
+    e.target.format = colorFormat;
+    e.inUse = true;
+    e.lastUse = ++useCounter;
+
+    GLenum pixelFormat = colorFormat == GL_RGBA8 ? GL_RGBA : GL_RGB;
+    glGenFramebuffers(1, &e.target.fbo);
+    glBindFramebuffer(GL_FRAMEBUFFER, e.target.fbo);
+
+    glGenTextures(1, &e.target.color);
+    glBindTexture(GL_TEXTURE_2D, e.target.color);
+    glTexImage2D(GL_TEXTURE_2D, 0, colorFormat, width, height, 0, pixelFormat, GL_UNSIGNED_BYTE, nullptr);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, e.target.color, 0);
+
+    glGenRenderbuffers(1, &e.target.depth);
+    glBindRenderbuffer(GL_RENDERBUFFER, e.target.depth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, width, height);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, e.target.depth);
+
+    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+        std::cout << "FBO incompleto!\n";
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+
+    MemTrackAlloc(MEM_GL, targetBytes(e.target));
+    createdCount++;
+    entries.push_back(e);
+    return e.target;
+}
+
+void RenderTargetPool::release(const RenderTarget &target)
+{
+    for (size_t i = 0; i < entries.size(); i++)
+        if (entries[i].target.fbo == target.fbo)
+            entries[i].inUse = false;
+    trimIdle();
+}
+
+void RenderTargetPool::clear()
+{
+    for (size_t i = 0; i < entries.size(); i++)
+        destroy(entries[i]);
+    entries.clear();
+}
+
+void RenderTargetPool::destroy(Entry &e)
+{
+    glDeleteFramebuffers(1, &e.target.fbo);
+    glDeleteTextures(1, &e.target.color);
+    glDeleteRenderbuffers(1, &e.target.depth);
+    MemTrackFree(MEM_GL, targetBytes(e.target));
+    e.target = RenderTarget();
+}
+
+// apaga os livres mais antigos até ficarem maxIdle
+void RenderTargetPool::trimIdle()
+{
+    while (true)
+    {
+        int idle = 0;
+        size_t oldest = entries.size();
+        for (size_t i = 0; i < entries.size(); i++)
+        {
+            if (entries[i].inUse)
+                continue;
+            idle++;
+            if (oldest == entries.size() || entries[i].lastUse < entries[oldest].lastUse)
+                oldest = i;
+        }
+        if (idle <= maxIdle)
+            return;
+        destroy(entries[oldest]);
+        entries.erase(entries.begin() + oldest);
+    }
+}
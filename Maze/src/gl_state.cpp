@@ -0,0 +1,81 @@
+#include <./include/gl_state.h>
+
+#include <cstring>
+
+RenderStats gRenderStats;
+
+namespace
+{
+    const int MAX_UNITS = 8;
+
+    // 0xFFFFFFFF = desconhecido (força o próximo bind)
+    const GLuint UNKNOWN = 0xFFFFFFFFu;
+
+    GLuint gProgram = UNKNOWN;
+    GLuint gVAO = UNKNOWN;
+    int gActiveUnit = -1;
+    GLuint gTextures[MAX_UNITS] = {UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN, UNKNOWN};
+}
+
+void ResetRenderStats()
+{
+    memset(&gRenderStats, 0, sizeof(gRenderStats));
+}
+
+void InvalidateGLState()
+{
+    gProgram = UNKNOWN;
+    gVAO = UNKNOWN;
+    gActiveUnit = -1;
+    for (int i = 0; i < MAX_UNITS; i++)
+        gTextures[i] = UNKNOWN;
+}
+
+void GLUseProgram(GLuint program)
+{
+    if (program == gProgram)
+    {
+        gRenderStats.stateChangesSkipped++;
+        return;
+    }
+    glUseProgram(program);
+    gProgram = program;
+    gRenderStats.stateChanges++;
+}
+
+void GLBindVertexArray(GLuint vao)
+{
+    if (vao == gVAO)
+    {
+        gRenderStats.stateChangesSkipped++;
+        return;
+    }
+    glBindVertexArray(vao);
+    gVAO = vao;
+    gRenderStats.stateChanges++;
+}
+
+void GLBindTexture2D(int unit, GLuint texture)
+{
+    if (unit < MAX_UNITS && gTextures[unit] == texture)
+    {
+        gRenderStats.stateChangesSkipped++;
+        return;
+    }
+    if (unit != gActiveUnit)
+    {
+        glActiveTexture(GL_TEXTURE0 + unit);
+        gActiveUnit = unit;
+    }
+    glBindTexture(GL_TEXTURE_2D, texture);
+    if (unit < MAX_UNITS)
+        gTextures[unit] = texture;
+    gRenderStats.stateChanges++;
+}
+
+void GLDrawTriangles(GLint first, GLsizei vertexCount)
+{
+    glDrawArrays(GL_TRIANGLES, first, vertexCount);
+    gRenderStats.drawCalls++;
+    gRenderStats.triangles += (unsigned)vertexCount / 3;
+}
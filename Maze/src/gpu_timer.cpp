@@ -0,0 +1,116 @@
+#include <./include/gpu_timer.h>
+#include <./include/profiler.h>
+
+#include <cstring>
+
+GpuTimer::GpuTimer() : enabled(false), count(0), frame(0), resolvedTotal(-1.0f), gpuToCpuNs(0)
+{
+    memset(names, 0, sizeof(names));
+    memset(ms, 0, sizeof(ms));
+    for (int p = 0; p < GPU_TIMER_MAX_PASSES; p++)
+        resolvedMs[p] = -1.0f;
+    memset(queries, 0, sizeof(queries));
+    memset(issued, 0, sizeof(issued));
+}
+
+bool GpuTimer::init()
+{
+    // GL_TIMESTAMP é core desde o 3.3, mas há drivers com 0 bits no contador
+    GLint bits = 0;
+    glGetQueryiv(GL_TIMESTAMP, GL_QUERY_COUNTER_BITS, &bits);
+    if (bits == 0)
+        return false;
+
+    glGenQueries(GPU_TIMER_FRAMES * GPU_TIMER_MAX_PASSES * 2, &queries[0][0][0]);
+    enabled = true;
+    syncClock();
+    return true;
+}
+
+void GpuTimer::shutdown()
+{
+    if (!enabled)
+        return;
+    glDeleteQueries(GPU_TIMER_FRAMES * GPU_TIMER_MAX_PASSES * 2, &queries[0][0][0]);
+    enabled = false;
+}
+
+int GpuTimer::addPass(const char *name)
+{
+    if (count == GPU_TIMER_MAX_PASSES)
+        return GPU_TIMER_MAX_PASSES - 1;
+    names[count] = name;
+    return count++;
+}
+
+void GpuTimer::syncClock()
+{
+    GLint64 gpuNow = 0;
+    glGetInteger64v(GL_TIMESTAMP, &gpuNow);
+    gpuToCpuNs = (long long)Profiler::nowNs() - (long long)gpuNow;
+}
+
+void GpuTimer::beginFrame()
+{
+    if (!enabled)
+        return;
+
+    frame++;
+    // os relógios afastam-se devagar: voltar a acertar de vez em quando
+    if (frame % 256 == 0)
+        syncClock();
+
+    // este conjunto foi usado há GPU_TIMER_FRAMES frames: ler o que já estiver pronto
+    int slot = frame % GPU_TIMER_FRAMES;
+    int issuedCount = 0;
+    bool complete = true;
+    resolvedTotal = 0.0f;
+    for (int p = 0; p < count; p++)
+    {
+        resolvedMs[p] = -1.0f;
+        if (!issued[slot][p])
+            continue;
+        issued[slot][p] = false;
+        issuedCount++;
+
+        GLint ready = 0;
+        glGetQueryObjectiv(queries[slot][p][1], GL_QUERY_RESULT_AVAILABLE, &ready);
+        if (!ready)
+        {
+            complete = false;
+            continue; // GPU muito atrasado: perde-se esta amostra em vez de esperar
+        }
+
+        GLuint64 t0 = 0, t1 = 0;
+        glGetQueryObjectui64v(queries[slot][p][0], GL_QUERY_RESULT, &t0);
+        glGetQueryObjectui64v(queries[slot][p][1], GL_QUERY_RESULT, &t1);
+
+        float passTime = (float)((t1 - t0) / 1.0e6);
+        ms[p] = ms[p] == 0.0f ? passTime : ms[p] * 0.9f + passTime * 0.1f;
+        resolvedMs[p] = passTime;
+        resolvedTotal += passTime;
+
+        long long start = (long long)t0 + gpuToCpuNs;
+        long long end = (long long)t1 + gpuToCpuNs;
+        if (start > 0 && end >= start)
+            Profiler::recordGpu(names[p], (uint64_t)start, (uint64_t)end);
+    }
+    if (!issuedCount || !complete)
+        resolvedTotal = -1.0f;
+}
+
+void GpuTimer::begin(int pass)
+{
+    if (!enabled)
+        return;
+    glQueryCounter(queries[frame % GPU_TIMER_FRAMES][pass][0], GL_TIMESTAMP);
+}
+
+void GpuTimer::end(int pass)
+{
+    if (!enabled)
+        return;
+    int slot = frame % GPU_TIMER_FRAMES;
+    glQueryCounter(queries[slot][pass][1], GL_TIMESTAMP);
+    issued[slot][pass] = true;
+}
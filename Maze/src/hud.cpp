@@ -0,0 +1,233 @@
+#include <./include/hud.h>
+#include <./include/gl_state.h>
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+// Fonte 5x7 (ASCII 32..95; minúsculas desenhadas como maiúsculas).
+// Uma linha por byte, bit 4 = coluna da esquerda.
+static const unsigned char FONT_5X7[64][7] = {
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00}, // ' '
+    {0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04}, // '!'
+    {0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00}, // '"'
+    {0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A}, // '#'
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04}, // '$' (sem desenho)
+    {0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03}, // '%'
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04}, // '&' (sem desenho)
+    {0x04, 0x04, 0x08, 0x00, 0x00, 0x00, 0x00}, // '''
+    {0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02}, // '('
+    {0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08}, // ')'
+    {0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00}, // '*'
+    {0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00}, // '+'
+    {0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08}, // ','
+    {0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00}, // '-'
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C}, // '.'
+    {0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00}, // '/'
+    {0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E}, // '0'
+    {0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E}, // '1'
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F}, // '2'
+    {0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E}, // '3'
+    {0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02}, // '4'
+    {0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E}, // '5'
+    {0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E}, // '6'
+    {0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08}, // '7'
+    {0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E}, // '8'
+    {0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C}, // '9'
+    {0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00}, // ':'
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04}, // ';' (sem desenho)
+    {0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02}, // '<'
+    {0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00}, // '='
+    {0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08}, // '>'
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04}, // '?'
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04}, // '@' (sem desenho)
+    {0x0E, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}, // 'A'
+    {0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E}, // 'B'
+    {0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E}, // 'C'
+    {0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C}, // 'D'
+    {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F}, // 'E'
+    {0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10}, // 'F'
+    {0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F}, // 'G'
+    {0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11}, // 'H'
+    {0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E}, // 'I'
+    {0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C}, // 'J'
+    {0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11}, // 'K'
+    {0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F}, // 'L'
+    {0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11}, // 'M'
+    {0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11}, // 'N'
+    {0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}, // 'O'
+    {0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10}, // 'P'
+    {0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D}, // 'Q'
+    {0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11}, // 'R'
+    {0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E}, // 'S'
+    {0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04}, // 'T'
+    {0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E}, // 'U'
+    {0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04}, // 'V'
+    {0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A}, // 'W'
+    {0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11}, // 'X'
+    {0x11, 0x11, 0x0A, 0x04, 0x04, 0x04, 0x04}, // 'Y'
+    {0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F}, // 'Z'
+    {0x0E, 0x08, 0x08, 0x08, 0x08, 0x08, 0x0E}, // '['
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04}, // 'backslash' (sem desenho)
+    {0x0E, 0x02, 0x02, 0x02, 0x02, 0x02, 0x0E}, // ']'
+    {0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04}, // '^' (sem desenho)
+    {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1F}, // '_'
+};
+
+// Atlas: células de 6x8 (glifo + 1 pixel de espaço), 16 por linha, 4 linhas de glifos
+// e uma quinta linha com uma célula toda acesa para os rectângulos sólidos
+static const int CELL_W = 6;
+static const int CELL_H = 8;
+static const int ATLAS_COLS = 16;
+static const int ATLAS_W = CELL_W * ATLAS_COLS;
+static const int ATLAS_H = CELL_H * 5;
+
+PerfHud::PerfHud() : batch(nullptr), layer(0), atlas(0), scale(2.0f), frameTimeNext(0)
+{
+    memset(frameTimes, 0, sizeof(frameTimes));
+}
+
+bool PerfHud::init(SpriteBatch &spriteBatch, int hudLayer)
+{
+    batch = &spriteBatch;
+    layer = hudLayer;
+
+    unsigned char pixels[ATLAS_W * ATLAS_H];
+    memset(pixels, 0, sizeof(pixels));
+
+    for (int g = 0; g < 64; g++)
+    {
+        int cx = (g % ATLAS_COLS) * CELL_W;
+        int cy = (g / ATLAS_COLS) * CELL_H;
+        for (int row = 0; row < 7; row++)
+            for (int col = 0; col < 5; col++)
+                if (FONT_5X7[g][row] & (0x10 >> col))
+                    pixels[(cy + row) * ATLAS_W + cx + col] = 255;
+    }
+    for (int y = 0; y < CELL_H; y++)
+        for (int x = 0; x < CELL_W; x++)
+            pixels[(4 * CELL_H + y) * ATLAS_W + x] = 255;
+
+    glGenTextures(1, &atlas);
+    glBindTexture(GL_TEXTURE_2D, atlas);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_R8, ATLAS_W, ATLAS_H, 0, GL_RED, GL_UNSIGNED_BYTE, pixels);
+    MemTrackAlloc(MEM_GL, ATLAS_W * ATLAS_H);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    // o shader do UI multiplica cor * textura: o glifo passa a ser branco com alfa = vermelho
+    GLint swizzle[4] = {GL_ONE, GL_ONE, GL_ONE, GL_RED};
+    glTexParameteriv(GL_TEXTURE_2D, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    InvalidateGLState();
+
+    return atlas != 0;
+}
+
+void PerfHud::shutdown()
+{
+    if (atlas)
+    {
+        glDeleteTextures(1, &atlas);
+        MemTrackFree(MEM_GL, ATLAS_W * ATLAS_H);
+    }
+    atlas = 0;
+    batch = nullptr;
+}
+
+void PerfHud::rect(float x, float y, float w, float h, unsigned int rgba)
+{
+    // meio da célula acesa (sem apanhar a vizinha com o NEAREST)
+    float u = (CELL_W * 0.5f) / ATLAS_W;
+    float v = (4 * CELL_H + CELL_H * 0.5f) / ATLAS_H;
+    batch->add(x, y, w, h, atlas, u, v, u, v, rgba, layer);
+}
+
+float PerfHud::text(float x, float y, const char *s, unsigned int rgba)
+{
+    float gw = 5 * scale, gh = 7 * scale;
+    for (; *s; s++)
+    {
+        int ch = (unsigned char)*s;
+        if (ch >= 'a' && ch <= 'z')
+            ch -= 'a' - 'A';
+        if (ch < 32 || ch > 95)
+            ch = '?';
+
+        if (ch != ' ')
+        {
+            int g = ch - 32;
+            float u0 = (float)((g % ATLAS_COLS) * CELL_W) / ATLAS_W;
+            float v0 = (float)((g / ATLAS_COLS) * CELL_H) / ATLAS_H;
+            batch->add(x, y, gw, gh, atlas, u0, v0, u0 + 5.0f / ATLAS_W, v0 + 7.0f / ATLAS_H, rgba, layer);
+        }
+        x += CELL_W * scale;
+    }
+    return x;
+}
+
+float PerfHud::textf(float x, float y, unsigned int rgba, const char *fmt, ...)
+{
+    char buf[256];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(buf, sizeof(buf), fmt, args);
+    va_end(args);
+    return text(x, y, buf, rgba);
+}
+
+void PerfHud::addFrameTime(float ms)
+{
+    frameTimes[frameTimeNext] = ms;
+    frameTimeNext = (frameTimeNext + 1) % HUD_GRAPH_FRAMES;
+}
+
+void PerfHud::frameTimeStats(float &avg, float &minMs, float &maxMs) const
+{
+    float sum = 0.0f;
+    int n = 0;
+    minMs = 1e9f;
+    maxMs = 0.0f;
+    for (int i = 0; i < HUD_GRAPH_FRAMES; i++)
+    {
+        if (frameTimes[i] <= 0.0f)
+            continue;
+        sum += frameTimes[i];
+        n++;
+        minMs = frameTimes[i] < minMs ? frameTimes[i] : minMs;
+        maxMs = frameTimes[i] > maxMs ? frameTimes[i] : maxMs;
+    }
+    avg = n ? sum / n : 0.0f;
+    if (!n)
+        minMs = 0.0f;
+}
+
+void PerfHud::graph(float x, float y, float w, float h, float maxMs)
+{
+    rect(x, y, w, h, SPRITE_RGBA(0, 0, 0, 140));
+
+    // linhas de referência: 60 Hz e 30 Hz
+    const float refs[2] = {1000.0f / 60.0f, 1000.0f / 30.0f};
+    for (int r = 0; r < 2; r++)
+        if (refs[r] < maxMs)
+            rect(x, y + h - h * refs[r] / maxMs, w, 1.0f, SPRITE_RGBA(255, 255, 255, 90));
+
+    float bw = w / HUD_GRAPH_FRAMES;
+    for (int i = 0; i < HUD_GRAPH_FRAMES; i++)
+    {
+        // mais antigo à esquerda
+        float ms = frameTimes[(frameTimeNext + i) % HUD_GRAPH_FRAMES];
+        if (ms <= 0.0f)
+            continue;
+        float bh = h * (ms < maxMs ? ms : maxMs) / maxMs;
+        unsigned int color = SPRITE_RGBA(90, 230, 120, 230);
+        if (ms > 1000.0f / 30.0f)
+            color = SPRITE_RGBA(255, 70, 70, 230);
+        else if (ms > 1000.0f / 60.0f)
+            color = SPRITE_RGBA(255, 200, 60, 230);
+        rect(x + i * bw, y + h - bh, bw > 1.0f ? bw - 1.0f : bw, bh, color);
+    }
+}
@@ -0,0 +1,150 @@
+#include <./include/ktx.h>
+
+#include <cstdio>
+#include <cstring>
+
+static const unsigned char KTX_IDENTIFIER[12] = {0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'};
+static const unsigned int KTX_ENDIAN_REF = 0x04030201;
+
+// Cabeçalho a seguir ao identificador (13 uint32)
+struct KtxHeader
+{
+    unsigned int endianness;
+    unsigned int glType;
+    unsigned int glTypeSize;
+    unsigned int glFormat;
+    unsigned int glInternalFormat;
+    unsigned int glBaseInternalFormat;
+    unsigned int pixelWidth;
+    unsigned int pixelHeight;
+    unsigned int pixelDepth;
+    unsigned int numberOfArrayElements;
+    unsigned int numberOfFaces;
+    unsigned int numberOfMipmapLevels;
+    unsigned int bytesOfKeyValueData;
+};
+
+static unsigned int Swap32(unsigned int v)
+{
+    return (v >> 24) | ((v >> 8) & 0xFF00) | ((v << 8) & 0xFF0000) | (v << 24);
+}
+
+bool LoadKTXFromMemory(const unsigned char *data, size_t size, KtxTexture &out)
+{
+    if (size < sizeof(KTX_IDENTIFIER) + sizeof(KtxHeader) || memcmp(data, KTX_IDENTIFIER, sizeof(KTX_IDENTIFIER)) != 0)
+        return false;
+
+    KtxHeader hdr;
+    memcpy(&hdr, data + sizeof(KTX_IDENTIFIER), sizeof(hdr));
+
+    bool swap = hdr.endianness != KTX_ENDIAN_REF;
+    if (swap)
+    {
+        unsigned int *words = (unsigned int *)&hdr;
+        for (size_t i = 0; i < sizeof(hdr) / 4; i++)
+            words[i] = Swap32(words[i]);
+        if (hdr.endianness != KTX_ENDIAN_REF)
+            return false;
+    }
+
+    // só texturas 2D comprimidas simples
+    if (hdr.glType != 0 || hdr.pixelDepth > 1 || hdr.numberOfArrayElements > 0 || hdr.numberOfFaces != 1)
+        return false;
+
+    out.glInternalFormat = hdr.glInternalFormat;
+    out.glBaseInternalFormat = hdr.glBaseInternalFormat;
+    out.width = (int)hdr.pixelWidth;
+    out.height = (int)hdr.pixelHeight;
+    out.levels.clear();
+
+    size_t pos = sizeof(KTX_IDENTIFIER) + sizeof(KtxHeader) + hdr.bytesOfKeyValueData;
+    unsigned int levelCount = hdr.numberOfMipmapLevels ? hdr.numberOfMipmapLevels : 1;
+
+    for (unsigned int level = 0; level < levelCount; level++)
+    {
+        if (pos + 4 > size)
+            return false;
+
+        unsigned int imageSize;
+        memcpy(&imageSize, data + pos, 4);
+        if (swap)
+            imageSize = Swap32(imageSize);
+        pos += 4;
+
+        if (pos + imageSize > size)
+            return false;
+
+        out.levels.push_back(TextureBytes(data + pos, data + pos + imageSize));
+        pos += (imageSize + 3) & ~3u; // mipPadding
+    }
+
+    return true;
+}
+
+bool LoadKTX(const char *path, KtxTexture &out)
+{
+    FILE *file = fopen(path, "rb");
+    if (!file)
+        return false;
+
+    std::vector<unsigned char> bytes;
+    fseek(file, 0, SEEK_END);
+    long len = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    if (len > 0)
+    {
+        bytes.resize((size_t)len);
+        if (fread(bytes.data(), 1, bytes.size(), file) != bytes.size())
+            bytes.clear();
+    }
+    fclose(file);
+
+    return !bytes.empty() && LoadKTXFromMemory(bytes.data(), bytes.size(), out);
+}
+
+bool SaveKTX(const char *path, const KtxTexture &tex)
+{
+    FILE *file = fopen(path, "wb");
+    if (!file)
+        return false;
+
+    KtxHeader hdr;
+    memset(&hdr, 0, sizeof(hdr));
+    hdr.endianness = KTX_ENDIAN_REF;
+    hdr.glTypeSize = 1;
+    hdr.glInternalFormat = tex.glInternalFormat;
+    hdr.glBaseInternalFormat = tex.glBaseInternalFormat;
+    hdr.pixelWidth = (unsigned int)tex.width;
+    hdr.pixelHeight = (unsigned int)tex.height;
+    hdr.numberOfFaces = 1;
+    hdr.numberOfMipmapLevels = (unsigned int)tex.levels.size();
+
+    fwrite(KTX_IDENTIFIER, 1, sizeof(KTX_IDENTIFIER), file);
+    fwrite(&hdr, sizeof(hdr), 1, file);
+
+    static const unsigned char padding[3] = {0, 0, 0};
+    for (size_t i = 0; i < tex.levels.size(); i++)
+    {
+        unsigned int imageSize = (unsigned int)tex.levels[i].size();
+        fwrite(&imageSize, 4, 1, file);
+        fwrite(tex.levels[i].data(), 1, imageSize, file);
+        fwrite(padding, 1, ((imageSize + 3) & ~3u) - imageSize, file);
+    }
+
+    bool ok = ferror(file) == 0;
+    fclose(file);
+    return ok;
+}
+
+std::string CookedTexturePath(const std::string &pngPath, const char *tag)
+{
+    size_t slash = pngPath.find_last_of('/');
+    std::string dir = slash == std::string::npos ? std::string() : pngPath.substr(0, slash + 1);
+    std::string name = slash == std::string::npos ? pngPath : pngPath.substr(slash + 1);
+
+    size_t dot = name.find_last_of('.');
+    if (dot != std::string::npos)
+        name = name.substr(0, dot);
+
+    return dir + "cooked/" + name + "." + tag + ".ktx";
+}
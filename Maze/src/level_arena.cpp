@@ -0,0 +1,79 @@
+#include <./include/level_arena.h>
+
+#include <cstdlib>
+#include <new>
+
+LevelArena::LevelArena(MemTag tag) : block(nullptr), size(0), offset(0), overflowBytes(0), peakBytes(0), tag(tag)
+{
+}
+
+LevelArena::~LevelArena()
+{
+    reset();
+    if (block)
+    {
+        MemTrackFree(tag, size);
+        free(block);
+    }
+}
+
+void LevelArena::reserve(size_t bytes)
+{
+    if (bytes <= size || used() != 0)
+        return;
+
+    if (block)
+    {
+        MemTrackFree(tag, size);
+        free(block);
+    }
+    block = (char *)malloc(bytes);
+    if (!block)
+        throw std::bad_alloc();
+    size = bytes;
+    MemTrackAlloc(tag, size);
+}
+
+void *LevelArena::allocate(size_t bytes, size_t align)
+{
+    size_t start = (offset + align - 1) & ~(align - 1);
+    if (block && start + bytes <= size)
+    {
+        offset = start + bytes;
+        if (used() > peakBytes)
+            peakBytes = used();
+        return block + start;
+    }
+
+    // não coube: bloco à parte só para isto (o malloc já alinha para qualquer tipo básico)
+    char *extra = (char *)malloc(bytes ? bytes : 1);
+    if (!extra)
+        throw std::bad_alloc();
+    Extra e = {extra, bytes};
+    overflow.push_back(e);
+    overflowBytes += bytes;
+    MemTrackAlloc(tag, bytes);
+    if (used() > peakBytes)
+        peakBytes = used();
+    return extra;
+}
+
+void LevelArena::reset()
+{
+    size_t levelBytes = used();
+    offset = 0;
+    if (overflow.empty())
+        return;
+
+    for (size_t i = 0; i < overflow.size(); i++)
+    {
+        MemTrackFree(tag, overflow[i].bytes);
+        free(overflow[i].data);
+    }
+    overflow.clear();
+    overflowBytes = 0;
+
+    // o nível que acabou não coube: o próximo do mesmo tamanho já cabe no bloco principal
+    // (com folga para o alinhamento das alocações que foram para fora)
+    reserve(levelBytes + levelBytes / 8);
+}
@@ -9,10 +9,45 @@
 #include <./include/camera.h>
 
 #include <./include/objloader.hpp>
+#include <./include/asset_loader.h>
+#include <./include/asset_manager.h>
+#include <./include/assetfs.h>
+#include <./include/file_watcher.h>
+#include <./include/frame_latency.h>
+#include <./include/frame_mailbox.h>
+#include <./include/gl_pool.h>
+#include <./include/gl_state.h>
+#include <./include/gpu_timer.h>
+#include <./include/hud.h>
+#include <./include/input_queue.h>
+#include <./include/level_arena.h>
+#include <./include/maze_grid.h>
+#include <./include/mem_tracker.h>
+#include <./include/profiler.h>
+#include <./include/replay.h>
+#include <./include/flythrough.h>
+#include <./include/offscreen.h>
+#include <./include/frame_capture.h>
+#include <./include/sprite_batch.h>
+#include <./include/telemetry.h>
 
 #include <iostream>
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
 #include <ctime>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include <sys/stat.h>
+#ifdef __linux__
+#include <unistd.h>
+#endif
 
 #include <./include/stb_image.h>
 #include <AL/al.h>
@@ -28,7 +63,7 @@ struct Rect
 struct Button
 {
     Rect r;
-    GLuint tex = 0;
+    TextureHandle tex = INVALID_TEXTURE;
     bool contains(float mx, float my) const
     {
         return mx >= r.x && mx <= (r.x + r.w) && my >= r.y && my <= (r.y + r.h);
@@ -38,12 +73,17 @@ struct Button
 static float gMouseX = 0.f, gMouseY = 0.f;
 static int gWinW = 1280, gWinH = 720;
 
-static GLuint texBg = 0;
+// MAZE_HEADLESS: sem janela visível; o render desenha num FBO próprio (OffscreenTarget)
+static bool gHeadless = false;
+static GLuint gPresentFBO = 0; // onde acaba o frame: 0 = janela, senão o FBO headless (thread de render)
+
+// Texturas do UI: carregadas só quando o ecrã que as usa aparece
+static AssetManager gAssets(64u << 20);
+
+static TextureHandle texBg = INVALID_TEXTURE;
 static Button btnStart, btnExitMain;
 static Button btnEasy, btnNormal, btnHard, btnExitMode;
 
-static GLuint uiVAO = 0, uiVBO = 0;
-
 enum class GameState
 {
     MENU_MAIN,
@@ -53,24 +93,87 @@ enum class GameState
 };
 GameState state = GameState::MENU_MAIN;
 
-static GLuint texVictory = 0;
+static TextureHandle texVictory = INVALID_TEXTURE;
 static Button btnExitVictory;
 
+// ===================== PACOTE DE FRAME (simulação -> render) =====================
+// Tudo o que a thread de render precisa para desenhar um frame. A thread principal
+// preenche-o depois dos ticks de simulação e publica-o em gFrames.
+// Camadas do SpriteBatch do UI (ordem de desenho; dentro da camada os quads não se sobrepõem)
+enum UILayer
+{
+    UI_LAYER_BACKGROUND = 0,
+    UI_LAYER_PANEL = 1, // imagem por cima do fundo (WINNER)
+    UI_LAYER_BUTTONS = 2,
+    UI_LAYER_HUD = 3
+};
+
+struct UIQuad
+{
+    Rect r;
+    TextureHandle tex;
+    int layer;
+};
+
+struct FramePacket
+{
+    GameState state = GameState::MENU_MAIN;
+    int winW = 0, winH = 0; // 0 = ainda nada publicado
+    unsigned serial = 0;    // conta as publicações (o render pode desenhar o mesmo pacote várias vezes)
+    double inputTime = 0.0; // primeiro input de jogo aplicado neste pacote (glfwGetTime), 0 = nenhum
+
+    // menu: fundo + botões do ecrã actual, pela ordem de desenho
+    UIQuad quads[6];
+    int quadCount = 0;
+
+    // jogo
+    unsigned levelSerial = 0; // muda em cada StartGame -> o render refaz chão / FBO
+    int choice = 2;
+    int mazeW = 0, mazeH = 0; // tamanho do labirinto (o chão cobre-o todo)
+    bool drunkMode = false;
+    std::shared_ptr<const ArenaArray<glm::vec3>> walls;  // visible set: posição de cada bloco
+    glm::vec3 prevPos, pos;                              // dois últimos ticks (o render interpola)
+    float simAlpha = 0.0f;                               // fração do tick seguinte já decorrida
+    double time = 0.0;                                   // glfwGetTime() na publicação
+    glm::vec3 front, up;
+    float zoom = 45.0f;
+    bool flashlightMode = true;
+    bool flashlightOn = true;
+    bool showHud = false;
+    bool replaying = false; // desenhar sempre e contar o frame nas estatísticas do replay
+    int flyRun = -1;        // benchmark de fly-through: índice em gFlyRuns (-1 = jogo normal)
+};
+
+static FrameMailbox<FramePacket> gFrames;
+
+// Nível actual (só a thread principal escreve; os pacotes partilham os blocos)
+static unsigned gLevelSerial = 0;
+static std::shared_ptr<const ArenaArray<glm::vec3>> gLevelWalls;
+
+// Arenas dos níveis. Os blocos de um nível vivem na sua arena e os pacotes de frame seguram-na
+// (o shared_ptr dos blocos partilha a posse da arena), por isso um nível novo fica com uma arena
+// que já nenhum pacote usa: normalmente duas a alternar, e só se cria outra se o render ainda
+// tiver ambas.
+static std::vector<std::shared_ptr<LevelArena>> gLevelArenas;
+static std::shared_ptr<LevelArena> gLevelArena;
+
 // protótipos UI (para poderes chamar no main)
-unsigned int LoadTextureRGBA(const char *path);
-void CreateUIQuad();
-void DrawRectUI(Shader &uiShader, const Rect &r, GLuint tex);
 glm::mat4 OrthoTopLeft(float w, float h);
 void BuildMenuLayout();
 
-// callbacks UI
+// callbacks (thread principal): só põem o evento na fila de input
 void cursor_pos_callback(GLFWwindow *window, double xpos, double ypos);
 void mouse_button_callback(GLFWwindow *window, int button, int action, int mods);
+void key_callback(GLFWwindow *window, int key, int scancode, int action, int mods);
+
+// tratamento do input na thread de simulação
+void HandleCursor(double xpos, double ypos);
+void HandleMenuClick(GLFWwindow *window);
 
 // =========================================================
 
 void framebuffer_size_callback(GLFWwindow *window, int width, int height);
-void mouse_callback(GLFWwindow *window, double xpos, double ypos);
+void window_refresh_callback(GLFWwindow *window);
 void scroll_callback(GLFWwindow *window, double xoffset, double yoffset);
 void processInput(GLFWwindow *window);
 // NEW camera functions
@@ -79,15 +182,13 @@ void increaseArrowSense();
 void decreaseArrowSense();
 
 // Texture prepare function
-void prepareTextures();
+void prepareTextures(AssetLoader &loader);
 
 // Funções para modos
 void setEasyMode();
 void setNormalMode();
 void setHardMode();
 
-bool checkCollision(glm::vec3 pos);
-
 void stopFootsteps();
 void startFootsteps();
 bool initAudio();
@@ -96,18 +197,8 @@ void shutdownAudio();
 void createFullScreenQuad();
 void createSceneFBO(int w, int h);
 
-// Tamanho do labirinto
-//
-int MAZE_W;
-int MAZE_H;
-const float CELL_SIZE = 1.0f;
-
-std::vector<std::vector<int>> maze;
-
 /*--------------------------------------*/
-int transferDataToGPUMemory(int choice);
-void generateMaze();
-void carveMaze(int x, int z);
+int transferDataToGPUMemory(DecodedMesh &wallMesh);
 
 // settings
 /*
@@ -115,10 +206,6 @@ const unsigned int SCR_WIDTH = 1920;
 const unsigned int SCR_HEIGHT = 1080;
 */
 
-// Raio do jogador para colisões
-//
-const float PLAYER_RADIUS = 0.10f;
-
 // Som
 //
 ALCdevice *alDevice = nullptr;
@@ -133,16 +220,75 @@ Camera camera(glm::vec3(-1.5f, 0.5f, 1.0f));
 float lastX;
 float lastY;
 bool firstMouse = true;
-float centerX;
-float centerY;
 bool fixY = true; // Controls if the player's Y is fixed or not
 
 float mouse_sense = 1.0f;
 float arrow_sense = 10.0f;
 
 // timing
+// A simulação (movimento + colisões) corre a passo fixo; deltaTime é sempre SIM_DT dentro de um tick
+const double SIM_DT = 1.0 / 120.0;
+const double SIM_MAX_FRAME = 0.25; // depois de um soluço simula no máximo isto (evita a espiral)
 float deltaTime = 0.0f;
-float lastFrame = 0.0f;
+// as setas e o M/N eram aplicados uma vez por frame (~60 Hz com vsync): por tick escalam-se
+// por deltaTime contra esta taxa para manter a mesma velocidade
+const float ARROW_REF_RATE = 60.0f;
+double lastTickTime = 0.0; // glfwGetTime() do último tick
+glm::vec3 prevCameraPos;   // posição no tick anterior (para interpolar no render)
+
+// Input: os callbacks GLFW (thread principal) põem os eventos com timestamp nesta fila e a
+// thread de simulação consome-os no início de cada tick
+static SpscRing<InputEvent, 1024> gInput;
+static std::atomic<unsigned> gInputDropped(0);
+
+// nos menus a simulação dorme até chegar input (PushInput acorda-a)
+static std::atomic<bool> gSimWaiting(false);
+static std::mutex gSimWakeMtx;
+static std::condition_variable gSimWakeCv;
+
+// janela exposta: publicar (e redesenhar) mesmo que a vista não tenha mudado
+static bool gViewDirty = true;
+
+// Gravação (MAZE_RECORD) e replay (MAZE_REPLAY) de um jogo; só a thread de simulação mexe
+// nisto, excepto gReplayResult.frameMs (render) e gRenderedSerial
+static unsigned gMazeSeed = 0;
+static unsigned gGameTick = 0; // ticks simulados desde o StartGame
+static double gGameStartTime = 0.0;
+static const char *gRecordPath = nullptr;
+static InputRecorder gRecorder;
+static InputReplay gReplay;
+static bool gReplaying = false;
+static bool gReplayFast = false; // MAZE_REPLAY_FAST=1: sem vsync, um tick por frame
+static double gReplayStart = 0.0;
+static ReplayResult gReplayResult;
+static std::atomic<unsigned> gRenderedSerial(0); // último pacote apresentado pelo render
+
+// Benchmark de fly-through (MAZE_FLYTHROUGH=<tamanhos>): a lista é criada antes das threads;
+// o sim preenche os dados do labirinto e o render os tempos de frame do tamanho actual
+static std::vector<FlythroughRun> gFlyRuns;
+static int gFlyRun = -1;
+static unsigned gFlySeed = 1;
+static int gFlyMaxFrames = 600;
+const float FLY_SPEED = 0.05f;    // células por frame (fixo: as corridas são comparáveis)
+const float FLY_LOOK_AHEAD = 0.6f; // olhar um pouco à frente suaviza as curvas
+const int FLY_WARMUP_FRAMES = 10;  // o primeiro frame de cada tamanho inclui o PrepareLevelGL
+
+// estado das teclas, só na thread de simulação; gKeyTapped guarda toques mais curtos que um tick
+static bool gKeyDown[GLFW_KEY_LAST + 1];
+static bool gKeyTapped[GLFW_KEY_LAST + 1];
+
+// cursor preso (jogo) ou livre (menus): decidido pela simulação, aplicado pela thread principal
+static std::atomic<bool> gCursorCaptured(false);
+
+// F12: a simulação escreve o trace do profiler em outputs/
+static bool gTraceRequested = false;
+
+// F3: HUD de desempenho (MAZE_HUD=1 arranca com ele ligado)
+static bool gShowHud = false;
+
+// latência: primeiro input ainda não publicado num pacote (thread de simulação)
+static double gPendingInputTime = 0.0;
+static unsigned gFrameSerial = 0;
 
 // lighting
 glm::vec3 lightPos(1.2f, 1.0f, 2.0f);
@@ -151,13 +297,9 @@ glm::vec3 lightPos(1.2f, 1.0f, 2.0f);
 char wall_mesh_File[] = "./meshes/wall.obj";
 
 // Wall
-std::vector<float> wall_bufferData;
+// (as cópias em CPU da mesh só vivem até ao upload; fica o número de vértices)
 unsigned int wall_VBO, wall_VAO;
-
-// Arrays que vão armazenar as coordenadas dos vertices, uvs e normais do objeto
-std::vector<glm::vec3> wall_vertices;
-std::vector<glm::vec2> wall_uvs;
-std::vector<glm::vec3> wall_normals;
+GLsizei wall_vertexCount = 0;
 
 // Wall Texture
 int wallWidth;
@@ -166,29 +308,38 @@ int wallNrChannels;
 char wall_texture_File[] = "./textures/bricks_wall_texture.png";
 unsigned int wallTexture;
 unsigned char *wallData;
+size_t wallTextureBytes = 0; // estimativa de GPU (MEM_GL)
 
 // Floor
-void generateFloor(int choice);
+void generateFloor(int mazeW, int mazeH);
 
-std::vector<glm::vec3> floor_vertices;
-std::vector<glm::vec2> floor_uvs;
-std::vector<glm::vec3> floor_normals;
+MeshVector<glm::vec3> floor_vertices;
+MeshVector<glm::vec2> floor_uvs;
+MeshVector<glm::vec3> floor_normals;
 
-std::vector<float> floor_bufferData;
+MeshVector<float> floor_bufferData;
 
-unsigned int floor_VBO, floor_VAO;
+// o VAO e o buffer ficam de um jogo para o outro: reinícios só reescrevem os vértices
+unsigned int floor_VAO;
+static PooledBuffer floor_buffer;
+GLsizei floor_vertexCount = 0;
 
 // Bebado
 //
-unsigned int sceneFBO = 0;
-unsigned int sceneColorTex = 0;
-unsigned int sceneRBO = 0;
+// alvo da cena no drunk mode, emprestado pelo pool (voltar ao hard não cria FBOs novos)
+static RenderTargetPool gTargetPool(2);
+static RenderTarget gSceneTarget;
 
 unsigned int quadVAO = 0, quadVBO = 0;
 
 int SCR_W = 1280;
 int SCR_H = 720;
 
+// Tempos de arranque (até ao primeiro frame)
+typedef std::chrono::steady_clock StartupClock;
+static StartupClock::time_point gStartupT0;
+static bool gFirstFramePresented = false;
+
 // Floor Texture
 int floorWidth;
 int floorHeight;
@@ -196,6 +347,7 @@ int floorNrChannels;
 char floor_texture_File[] = "./textures/floor_texture.png";
 unsigned int floorTexture;
 unsigned char *floorData;
+size_t floorTextureBytes = 0;
 
 // Spotlight
 float ambientLightStrengh = 0.1f;
@@ -230,46 +382,469 @@ void setHardMode()
     // Colcocar depois o filtro de bebado, noite e uma lanterna
 }
 
-static void DestroyDrunkResources()
+static void StartupMark(const char *what)
 {
-    if (sceneFBO)
+    double ms = std::chrono::duration<double, std::milli>(StartupClock::now() - gStartupT0).count();
+    std::cout << "[startup] " << ms << " ms  " << what << "\n";
+}
+
+static void MarkFirstFrame()
+{
+    if (gFirstFramePresented)
+        return;
+    gFirstFramePresented = true;
+    StartupMark("primeiro frame apresentado (time to first frame)");
+}
+
+// Texturas usadas por cada ecrã
+static void ScreenTextures(GameState s, std::vector<TextureHandle> &out)
+{
+    if (s == GameState::MENU_MAIN)
+    {
+        out.push_back(texBg);
+        out.push_back(btnStart.tex);
+        out.push_back(btnExitMain.tex);
+    }
+    else if (s == GameState::MENU_MODE)
+    {
+        out.push_back(texBg);
+        out.push_back(btnEasy.tex);
+        out.push_back(btnNormal.tex);
+        out.push_back(btnHard.tex);
+        out.push_back(btnExitMode.tex);
+    }
+    else if (s == GameState::VICTORY)
     {
-        glDeleteFramebuffers(1, &sceneFBO);
-        sceneFBO = 0;
+        out.push_back(texBg);
+        out.push_back(texVictory);
+        out.push_back(btnExitVictory.tex);
     }
-    if (sceneColorTex)
+}
+
+// Thread de render, quando o pacote traz outro ecrã: as texturas do novo ecrã ficam
+// referenciadas, as do anterior podem ser despejadas
+static void SwitchScreenTextures(GameState from, GameState to)
+{
+    std::vector<TextureHandle> oldTex, newTex;
+    ScreenTextures(from, oldTex);
+    ScreenTextures(to, newTex);
+
+    for (size_t i = 0; i < newTex.size(); i++)
+        gAssets.acquire(newTex[i]);
+    for (size_t i = 0; i < oldTex.size(); i++)
+        gAssets.release(oldTex[i]);
+
+    gAssets.trim();
+}
+
+// Muda de ecrã (thread de simulação); as texturas mudam quando o render vir o novo estado
+// e o modo do cursor quando a thread principal acordar
+static void SetState(GameState next)
+{
+    if (next != GameState::PLAYING && gRecorder.isOpen())
+        gRecorder.close(gGameTick);
+
+    state = next;
+    BuildMenuLayout();
+
+    gCursorCaptured = (next == GameState::PLAYING);
+    glfwPostEmptyEvent();
+}
+
+// Thread principal: cursor preso com movimento raw do rato (quando existe) no jogo, livre nos menus
+static void ApplyCursorMode(GLFWwindow *window, bool captured)
+{
+    glfwSetInputMode(window, GLFW_CURSOR, captured ? GLFW_CURSOR_DISABLED : GLFW_CURSOR_NORMAL);
+    if (glfwRawMouseMotionSupported())
+        glfwSetInputMode(window, GLFW_RAW_MOUSE_MOTION, captured ? GLFW_TRUE : GLFW_FALSE);
+}
+
+static void WakeSimulation()
+{
+    if (gSimWaiting.load())
     {
-        glDeleteTextures(1, &sceneColorTex);
-        sceneColorTex = 0;
+        std::lock_guard<std::mutex> lock(gSimWakeMtx);
+        gSimWakeCv.notify_one();
     }
-    if (sceneRBO)
+}
+
+// Thread de simulação nos menus: espera por input (ou por quit) sem gastar CPU;
+// o timeout é só uma rede de segurança
+static void WaitForInput(std::chrono::milliseconds timeout, const std::atomic<bool> &quit)
+{
+    InputEvent ev;
+    std::unique_lock<std::mutex> lock(gSimWakeMtx);
+    gSimWaiting.store(true);
+    gSimWakeCv.wait_for(lock, timeout, [&ev, &quit]
+                        { return quit.load() || gInput.peek(ev); });
+    gSimWaiting.store(false);
+}
+
+static void PushInput(InputEvent::Type type, int code, int action, double x, double y)
+{
+    InputEvent ev = {type, code, action, x, y, glfwGetTime()};
+    if (!gInput.push(ev))
+        gInputDropped++;
+    WakeSimulation();
+}
+
+// Thread de simulação: aplica um evento da fila
+static void HandleInput(const InputEvent &ev, GLFWwindow *window)
+{
+    // para medir a latência input -> imagem (os eventos chegam por ordem)
+    if (state == GameState::PLAYING && (ev.type == InputEvent::KEY || ev.type == InputEvent::CURSOR) && gPendingInputTime == 0.0)
+        gPendingInputTime = ev.time;
+
+    switch (ev.type)
     {
-        glDeleteRenderbuffers(1, &sceneRBO);
-        sceneRBO = 0;
+    case InputEvent::KEY:
+        if (ev.code < 0 || ev.code > GLFW_KEY_LAST)
+            break;
+        gKeyDown[ev.code] = ev.action != GLFW_RELEASE;
+        if (ev.action != GLFW_PRESS)
+            break;
+        gKeyTapped[ev.code] = true;
+
+        if (state == GameState::PLAYING)
+        {
+            if (ev.code == GLFW_KEY_ESCAPE)
+            {
+                glfwSetWindowShouldClose(window, true);
+                glfwPostEmptyEvent();
+            }
+            else if (ev.code == GLFW_KEY_L) // Ativar/desativar o filtro
+                fixY = !fixY;
+            else if (ev.code == GLFW_KEY_F) // Flashlight
+                flashlightOn = !flashlightOn;
+        }
+        if (ev.code == GLFW_KEY_F12)
+            gTraceRequested = true;
+        else if (ev.code == GLFW_KEY_F3)
+            gShowHud = !gShowHud;
+        break;
+    case InputEvent::CURSOR:
+        HandleCursor(ev.x, ev.y);
+        break;
+    case InputEvent::BUTTON:
+        if (ev.code == GLFW_MOUSE_BUTTON_LEFT && ev.action == GLFW_PRESS)
+            HandleMenuClick(window);
+        break;
+    case InputEvent::SCROLL:
+        camera.ProcessMouseScroll((float)ev.y);
+        break;
+    case InputEvent::RESIZE:
+        if ((int)ev.x != gWinW || (int)ev.y != gWinH)
+        {
+            gWinW = (int)ev.x;
+            gWinH = (int)ev.y;
+            BuildMenuLayout();
+        }
+        break;
+    case InputEvent::REFRESH:
+        gViewDirty = true;
+        break;
     }
 }
 
-static void RebuildFloor(int choice)
+// tecla em baixo neste tick (ou carregada e largada desde o tick anterior)
+static bool KeyDown(int key)
+{
+    return gKeyDown[key] || gKeyTapped[key];
+}
+
+// Começa um nível: larga o anterior e devolve uma arena livre, vazia e com espaço para
+// um labirinto de MAZE_W x MAZE_H (só a thread que gera níveis)
+static LevelArena &BeginLevelArena()
 {
-    // apagar VAO/VBO antigo
-    if (floor_VAO)
+    gLevelWalls.reset();
+    gLevelArena.reset();
+    maze.clear();
+
+    for (size_t i = 0; i < gLevelArenas.size() && !gLevelArena; i++)
+        if (gLevelArenas[i].use_count() == 1) // só esta lista: nenhum pacote a usa
+            gLevelArena = gLevelArenas[i];
+    if (!gLevelArena)
     {
-        glDeleteVertexArrays(1, &floor_VAO);
-        floor_VAO = 0;
+        gLevelArena = std::make_shared<LevelArena>(MEM_MAZE);
+        gLevelArenas.push_back(gLevelArena);
+    }
+
+    gLevelArena->reset();
+    gLevelArena->reserve(LevelArenaBytes(MAZE_W, MAZE_H));
+    return *gLevelArena;
+}
+
+// Posições dos blocos do labirinto actual, partilhadas (só leitura) pelos pacotes de frame
+static void BuildLevelWalls()
+{
+    size_t count = 0;
+    for (int z = 0; z < MAZE_H; z++)
+        for (int x = 0; x < MAZE_W; x++)
+            count += maze[z][x] == 1; // arbusto
+
+    glm::vec3 *blocks = gLevelArena->allocArray<glm::vec3>(count);
+    size_t n = 0;
+    for (int z = 0; z < MAZE_H; z++)
+        for (int x = 0; x < MAZE_W; x++)
+            if (maze[z][x] == 1)
+                blocks[n++] = glm::vec3((x + 0.5f) * CELL_SIZE, 0.0f, (z + 0.5f) * CELL_SIZE);
+
+    // o array é só um ponteiro para a arena: o shared_ptr (aliasing) mantém a arena viva
+    ArenaArray<glm::vec3> *walls = gLevelArena->allocArray<ArenaArray<glm::vec3>>(1);
+    *walls = ArenaArray<glm::vec3>(blocks, count);
+    gLevelWalls = std::shared_ptr<const ArenaArray<glm::vec3>>(gLevelArena, walls);
+    gLevelSerial++;
+}
+
+static void AddQuad(FramePacket &frame, const Rect &r, TextureHandle tex, int layer)
+{
+    frame.quads[frame.quadCount].r = r;
+    frame.quads[frame.quadCount].tex = tex;
+    frame.quads[frame.quadCount].layer = layer;
+    frame.quadCount++;
+}
+
+// Thread de simulação: fotografa o estado actual para a thread de render
+static void PublishFrame()
+{
+    PROFILE_SCOPE("PublishFrame");
+
+    FramePacket &frame = gFrames.writeSlot();
+
+    frame.state = state;
+    frame.winW = gWinW;
+    frame.winH = gWinH;
+    frame.serial = ++gFrameSerial;
+    frame.inputTime = gPendingInputTime;
+    gPendingInputTime = 0.0;
+
+    frame.quadCount = 0;
+    Rect bg = {0, 0, (float)gWinW, (float)gWinH};
+    if (state != GameState::PLAYING)
+        AddQuad(frame, bg, texBg, UI_LAYER_BACKGROUND);
+    if (state == GameState::MENU_MAIN)
+    {
+        AddQuad(frame, btnStart.r, btnStart.tex, UI_LAYER_BUTTONS);
+        AddQuad(frame, btnExitMain.r, btnExitMain.tex, UI_LAYER_BUTTONS);
+    }
+    else if (state == GameState::MENU_MODE)
+    {
+        AddQuad(frame, btnEasy.r, btnEasy.tex, UI_LAYER_BUTTONS);
+        AddQuad(frame, btnNormal.r, btnNormal.tex, UI_LAYER_BUTTONS);
+        AddQuad(frame, btnHard.r, btnHard.tex, UI_LAYER_BUTTONS);
+        AddQuad(frame, btnExitMode.r, btnExitMode.tex, UI_LAYER_BUTTONS);
+    }
+    else if (state == GameState::VICTORY)
+    {
+        // fundo é a imagem do WINNER
+        AddQuad(frame, bg, texVictory, UI_LAYER_PANEL);
+        AddQuad(frame, btnExitVictory.r, btnExitVictory.tex, UI_LAYER_BUTTONS);
+    }
+
+    frame.levelSerial = gLevelSerial;
+    frame.choice = gChoice;
+    frame.mazeW = MAZE_W;
+    frame.mazeH = MAZE_H;
+    frame.drunkMode = gDrunkMode;
+    frame.walls = gLevelWalls;
+    frame.prevPos = prevCameraPos;
+    frame.pos = camera.Position;
+    frame.time = glfwGetTime();
+    frame.simAlpha = (float)((frame.time - lastTickTime) / SIM_DT);
+    frame.front = camera.Front;
+    frame.up = camera.Up;
+    frame.zoom = camera.Zoom;
+    frame.flashlightMode = flashlightMode;
+    frame.flashlightOn = flashlightOn;
+    frame.showHud = gShowHud;
+    frame.replaying = gReplaying;
+    frame.flyRun = gFlyRun;
+
+    gFrames.publish();
+}
+
+// Tudo o que decide o aspecto do frame: se não mudou desde a última publicação, o frame
+// desenhado seria igual ao que já está no ecrã
+struct ViewKey
+{
+    GameState state;
+    int winW, winH;
+    unsigned levelSerial;
+    glm::vec3 prevPos, pos, front, up;
+    float zoom;
+    bool flashlightOn, showHud;
+
+    bool operator==(const ViewKey &o) const
+    {
+        return state == o.state && winW == o.winW && winH == o.winH && levelSerial == o.levelSerial &&
+               prevPos == o.prevPos && pos == o.pos && front == o.front && up == o.up && zoom == o.zoom &&
+               flashlightOn == o.flashlightOn && showHud == o.showHud;
+    }
+};
+
+static ViewKey CurrentView()
+{
+    ViewKey v = {state, gWinW, gWinH, gLevelSerial, prevCameraPos, camera.Position, camera.Front, camera.Up,
+                 camera.Zoom, flashlightOn, gShowHud};
+    return v;
+}
+
+static bool AnyKeyDown()
+{
+    for (int k = 0; k <= GLFW_KEY_LAST; k++)
+        if (gKeyDown[k])
+            return true;
+    return false;
+}
+
+static bool HasGLExtension(const char *name)
+{
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+    for (GLint i = 0; i < count; i++)
+    {
+        const char *ext = (const char *)glGetStringi(GL_EXTENSIONS, i);
+        if (ext && strcmp(ext, name) == 0)
+            return true;
     }
-    if (floor_VBO)
+    return false;
+}
+
+// memória residente do processo (MB), 0 se não houver /proc
+static float ProcessRssMB()
+{
+#ifdef __linux__
+    long pages = 0, resident = 0;
+    FILE *f = fopen("/proc/self/statm", "r");
+    if (!f)
+        return 0.0f;
+    if (fscanf(f, "%ld %ld", &pages, &resident) != 2)
+        resident = 0;
+    fclose(f);
+    return (float)resident * (float)sysconf(_SC_PAGESIZE) / (1024.0f * 1024.0f);
+#else
+    return 0.0f;
+#endif
+}
+
+// Thread de render: põe o HUD no batch do UI (os contadores são os do frame anterior, completo)
+static void BuildPerfHud(PerfHud &hud, const GpuTimer &gpuTimer, const RenderStats &stats)
+{
+    PROFILE_SCOPE("perf HUD");
+
+    float avg, minMs, maxMs;
+    hud.frameTimeStats(avg, minMs, maxMs);
+
+    float x = 8.0f, y = 8.0f;
+    float line = hud.lineHeight();
+    float width = 30.0f * hud.charWidth();
+    int lines = 9 + gpuTimer.passCount();
+
+    hud.rect(x - 4.0f, y - 4.0f, width + 8.0f, lines * line + 48.0f, SPRITE_RGBA(0, 0, 0, 160));
+
+    unsigned int white = SPRITE_RGBA(255, 255, 255, 255);
+    unsigned int grey = SPRITE_RGBA(170, 170, 170, 255);
+    hud.textf(x, y, white, "FPS %.0f  %.2f MS", avg > 0.0f ? 1000.0f / avg : 0.0f, avg);
+    y += line;
+    hud.textf(x, y, grey, "MIN %.2f  MAX %.2f", minMs, maxMs);
+    y += line + 2.0f;
+
+    hud.graph(x, y, width, 40.0f, 33.3f);
+    y += 44.0f;
+
+    hud.textf(x, y, white, "DRAWS %u  TRIS %u", stats.drawCalls, stats.triangles);
+    y += line;
+    hud.textf(x, y, white, "UNIFORMS %u", stats.uniformUploads);
+    y += line;
+    hud.textf(x, y, white, "BINDS %u  SKIPPED %u", stats.stateChanges, stats.stateChangesSkipped);
+    y += line;
+
+    for (int p = 0; p < gpuTimer.passCount(); p++)
+    {
+        hud.textf(x, y, grey, "%s %.2f", gpuTimer.passName(p), gpuTimer.passMs(p));
+        y += line;
+    }
+
+    hud.textf(x, y, white, "RSS %.1f MB  TEX %.1f MB", ProcessRssMB(), gAssets.gpuBytes() / (1024.0f * 1024.0f));
+    y += line;
+
+    // memória contada por tag (MB actuais)
+    const float MB = 1.0f / (1024.0f * 1024.0f);
+    hud.textf(x, y, white, "HEAP %.2f MB  PEAK %.2f MB", MemHeapCurrent() * MB, MemHeapPeak() * MB);
+    y += line;
+    hud.textf(x, y, grey, "MAZE %.1f  MESH %.1f  TEX %.1f", MemStats(MEM_MAZE).current * MB,
+              MemStats(MEM_MESH).current * MB, MemStats(MEM_TEXTURE).current * MB);
+    y += line;
+    hud.textf(x, y, grey, "AUDIO %.1f  UI %.1f  GL %.1f", MemStats(MEM_AUDIO).current * MB,
+              MemStats(MEM_UI).current * MB, MemStats(MEM_GL).current * MB);
+}
+
+// Hot-reload: recompila só os shaders cujos ficheiros mudaram (se falhar fica o programa antigo)
+// devolve true se algum programa mudou
+static bool ReloadChangedShaders(FileWatcher &watcher, Shader *const shaders[], int count)
+{
+    std::vector<std::string> changed;
+    if (!watcher.takeChanged(changed))
+        return false;
+
+    bool reloaded = false;
+    for (int i = 0; i < count; i++)
     {
-        glDeleteBuffers(1, &floor_VBO);
-        floor_VBO = 0;
+        bool affected = false;
+        for (size_t j = 0; j < changed.size() && !affected; j++)
+            affected = shaders[i]->usesFile(changed[j]);
+        if (!affected)
+            continue;
+
+        if (shaders[i]->reload())
+        {
+            std::cout << "[shaders] recompilado (programa " << shaders[i]->ID << ")\n";
+            reloaded = true;
+        }
+        else
+            std::cout << "[shaders] erro ao recompilar, mantém-se o programa anterior\n";
     }
+    return reloaded;
+}
+
+// Um tick de simulação; devolve true quando o jogador chega à saída
+static bool SimulationTick(GLFWwindow *window)
+{
+    PROFILE_SCOPE("SimulationTick");
+
+    prevCameraPos = camera.Position;
+    deltaTime = (float)SIM_DT;
+    processInput(window);
+
+    // Verifica se o jogador chegou ao fim do labirinto
+    int px = (int)floor(camera.Position.x / CELL_SIZE);
+    int pz = (int)floor(camera.Position.z / CELL_SIZE);
+    return pz == MAZE_H - 2 && px == MAZE_W - 1;
+}
+
+// VBO das meshes: 8 floats por vértice (pos, normal, uv)
+static size_t MeshGpuBytes(GLsizei vertexCount)
+{
+    return (size_t)vertexCount * 8 * sizeof(float);
+}
+
+// devolve o alvo da cena ao pool (fica lá para o próximo jogo no hard)
+static void ReleaseDrunkResources()
+{
+    if (gSceneTarget.valid())
+        gTargetPool.release(gSceneTarget);
+    gSceneTarget = RenderTarget();
+}
 
+static void RebuildFloor(int mazeW, int mazeH)
+{
     // limpar buffers/vetores para não irem acumulando
     floor_vertices.clear();
     floor_uvs.clear();
     floor_normals.clear();
     floor_bufferData.clear();
 
-    generateFloor(choice); // cria novo VAO/VBO com base no choice
+    generateFloor(mazeW, mazeH); // reescreve o VBO (o VAO é o mesmo) com o tamanho do labirinto
 }
 
 static void SpawnCameraAtFirstPathCell()
@@ -294,6 +869,28 @@ static void StartGame(int choice, GLFWwindow *window)
 {
     gChoice = choice;
 
+    // estado inicial gravado (a câmara mantém a orientação do jogo anterior)
+    gMazeSeed = gReplaying ? gReplay.header().seed : (unsigned)time(NULL);
+    gGameTick = 0;
+    gGameStartTime = glfwGetTime();
+    if (gRecordPath && !gReplaying)
+    {
+        ReplayHeader h;
+        h.seed = gMazeSeed;
+        h.mode = choice;
+        h.yaw = camera.Yaw;
+        h.pitch = camera.Pitch;
+        h.zoom = camera.Zoom;
+        h.mouseSense = mouse_sense;
+        h.arrowSense = arrow_sense;
+        h.fixY = fixY;
+        h.flashlightOn = flashlightOn;
+        if (gRecorder.open(gRecordPath, h))
+            std::cout << "[replay] a gravar em " << gRecordPath << " (seed " << gMazeSeed << ")\n";
+        else
+            std::cout << "[replay] erro a abrir " << gRecordPath << "\n";
+    }
+
     if (choice == 1)
         setEasyMode();
     else if (choice == 2)
@@ -301,46 +898,292 @@ static void StartGame(int choice, GLFWwindow *window)
     else
         setHardMode();
 
-    // Maze novo com novo tamanho
-    maze.clear();
-    srand((unsigned)time(NULL));
-    generateMaze();
-
-    // Chão novo (tamanho depende do choice)
-    RebuildFloor(choice);
+    // Maze novo com novo tamanho (o anterior sai todo de uma vez com a sua arena)
+    LevelArena &arena = BeginLevelArena();
+    srand(gMazeSeed);
+    generateMaze(arena);
+    BuildLevelWalls(); // o chão e o FBO são refeitos pelo render (PrepareLevelGL)
 
     // Drunk-mode só no hard
-    bool wantDrunk = (choice == 3);
-    if (wantDrunk)
+    gDrunkMode = (choice == 3);
+
+    // Spawn do jogador
+    SpawnCameraAtFirstPathCell();
+
+    prevCameraPos = camera.Position;
+
+    // Preparar rato FPS (o cursor é preso pela thread principal no SetState)
+    firstMouse = true;
+
+    // Entrar no jogo
+    SetState(GameState::PLAYING);
+}
+
+// Thread de simulação: começa o jogo gravado, com o mesmo estado inicial
+static void StartReplay(GLFWwindow *window)
+{
+    const ReplayHeader &h = gReplay.header();
+    camera.Yaw = h.yaw;
+    camera.Pitch = h.pitch;
+    camera.ProcessMouseMovement(0.0f, 0.0f); // recalcula Front/Right/Up
+    camera.Zoom = h.zoom;
+    mouse_sense = h.mouseSense;
+    arrow_sense = h.arrowSense;
+    fixY = h.fixY;
+    flashlightOn = h.flashlightOn;
+    memset(gKeyDown, 0, sizeof(gKeyDown));
+
+    gReplaying = true;
+    gReplayResult.header = h;
+    gReplayResult.unthrottled = gReplayFast;
+    gReplayStart = glfwGetTime();
+    StartGame(h.mode, window);
+}
+
+static void FinishReplay(GLFWwindow *window, bool completed)
+{
+    gReplaying = false;
+    gReplayResult.completed = completed;
+    gReplayResult.ticks = gGameTick;
+    gReplayResult.wallSeconds = glfwGetTime() - gReplayStart;
+
+    glfwSetWindowShouldClose(window, true);
+    glfwPostEmptyEvent();
+}
+
+// Thread de simulação, depois de cada tick de jogo: grava a câmara ou compara-a com a gravação
+static void SampleReplayCamera()
+{
+    if (gGameTick % REPLAY_CAMERA_EVERY != 0)
+        return;
+
+    if (gRecorder.isOpen())
+        gRecorder.camera(gGameTick, camera.Position, camera.Yaw, camera.Pitch);
+
+    ReplayCameraSample s;
+    if (gReplaying && gReplay.cameraAt(gGameTick, s))
     {
-        // garante FBO com o tamanho actual
-        createSceneFBO(gWinW, gWinH);
-        if (quadVAO == 0)
-            createFullScreenQuad();
+        float drift = glm::length(camera.Position - s.pos);
+        if (drift > gReplayResult.maxCameraDrift)
+            gReplayResult.maxCameraDrift = drift;
+    }
+}
+
+// Thread de simulação: benchmark de fly-through. Para cada tamanho gera o labirinto com a
+// seed fixa, resolve-o e leva a câmara pelo caminho da entrada à saída, um pacote por frame
+// (à espera que o render o apresente); no fim fecha a janela e o main escreve o relatório.
+static void RunFlythrough(GLFWwindow *window, const std::atomic<bool> &quit)
+{
+    std::vector<glm::vec3> path;
+    PathFollower follower;
+
+    for (size_t r = 0; r < gFlyRuns.size() && !quit.load(); r++)
+    {
+        FlythroughRun &run = gFlyRuns[r];
+
+        // como o normal, sem o drunk mode, no tamanho pedido
+        setNormalMode();
+        MAZE_W = MAZE_H = run.size;
+        gChoice = 2;
+        gDrunkMode = false;
+        flashlightOn = true;
+
+        LevelArena &arena = BeginLevelArena();
+        srand(run.seed);
+        generateMaze(arena);
+        BuildLevelWalls();
+
+        if (!SolveMaze(maze, arena, 0, 1, MAZE_W - 1, MAZE_H - 2, path, CELL_SIZE, 0.5f))
+        {
+            std::cout << "[flythrough] labirinto " << run.size << " sem solução\n";
+            continue;
+        }
+        run.walls = gLevelWalls->size();
+        run.pathCells = path.size();
+        follower.reset(path);
+
+        std::cout << "[flythrough] " << run.size << "x" << run.size << ": " << run.walls << " blocos, caminho de "
+                  << run.pathCells << " células\n";
+
+        gFlyRun = (int)r;
+        SetState(GameState::PLAYING);
+
+        for (int f = 0; f < gFlyMaxFrames + FLY_WARMUP_FRAMES && !quit.load(); f++)
+        {
+            glm::vec3 front = follower.front(FLY_LOOK_AHEAD * CELL_SIZE);
+            camera.Position = follower.position();
+            camera.Yaw = glm::degrees(atan2f(front.z, front.x));
+            camera.Pitch = 0.0f;
+            camera.ProcessMouseMovement(0.0f, 0.0f); // recalcula Front/Right/Up
+            prevCameraPos = camera.Position;         // sem interpolação: o frame mostra esta posição
+            lastTickTime = glfwGetTime();
+
+            PublishFrame();
+            while (gRenderedSerial.load() < gFrameSerial && !quit.load())
+                std::this_thread::yield();
+
+            if (!follower.advance(FLY_SPEED * CELL_SIZE))
+                break;
+        }
+    }
+
+    gFlyRun = -1;
+    glfwSetWindowShouldClose(window, true);
+    glfwPostEmptyEvent();
+}
+
+// Janela invisível com um contexto EGL (pbuffer / surfaceless) e, se não houver EGL, OSMesa
+// (llvmpipe, só CPU); MAZE_HEADLESS_API=osmesa salta o EGL. O frame vai para o OffscreenTarget.
+static GLFWwindow *CreateHeadlessWindow(int width, int height)
+{
+    glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+    GLFWwindow *window = NULL;
+    const char *api = getenv("MAZE_HEADLESS_API");
+    if (!api || strcmp(api, "osmesa") != 0)
+    {
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_EGL_CONTEXT_API);
+        window = glfwCreateWindow(width, height, "Maze", NULL, NULL);
+        if (window)
+            std::cout << "[headless] contexto EGL " << width << "x" << height << "\n";
+    }
+    if (!window)
+    {
+        glfwWindowHint(GLFW_CONTEXT_CREATION_API, GLFW_OSMESA_CONTEXT_API);
+        window = glfwCreateWindow(width, height, "Maze", NULL, NULL);
+        if (window)
+            std::cout << "[headless] contexto OSMesa " << width << "x" << height << "\n";
+    }
+    return window;
+}
+
+// Trace do profiler (Chrome trace_event); sem caminho vai para outputs/trace_<n>.json
+static void DumpTrace(const char *path)
+{
+    static int traceCount = 0;
+    std::string file;
+    if (path)
+    {
+        file = path;
     }
     else
     {
-        DestroyDrunkResources();
+        mkdir("./outputs", 0755);
+        file = "./outputs/trace_" + std::to_string(++traceCount) + ".json";
     }
-    gDrunkMode = wantDrunk;
 
-    // Spawn do jogador
-    SpawnCameraAtFirstPathCell();
+    if (!Profiler::dump(file))
+        std::cout << "[profiler] não consegui escrever " << file << "\n";
+}
 
-    // Preparar rato FPS
-    firstMouse = true;
-    glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_HIDDEN);
+// Thread de render: recursos GL do nível novo
+static void PrepareLevelGL(const FramePacket &frame)
+{
+    PROFILE_SCOPE("PrepareLevelGL");
 
-    // Entrar no jogo
-    state = GameState::PLAYING;
+    // Chão novo (do tamanho do labirinto)
+    RebuildFloor(frame.mazeW, frame.mazeH);
+
+    if (frame.drunkMode)
+    {
+        // garante FBO com o tamanho actual
+        createSceneFBO(frame.winW, frame.winH);
+        if (quadVAO == 0)
+            createFullScreenQuad();
+    }
+    else
+    {
+        ReleaseDrunkResources();
+    }
 }
 
 int main()
 {
+    gStartupT0 = StartupClock::now();
+
+    // MAZE_PROFILE=0 desliga o profiler; MAZE_TRACE=<ficheiro> escreve o trace ao sair
+    if (getenv("MAZE_PROFILE") && strcmp(getenv("MAZE_PROFILE"), "0") == 0)
+        Profiler::setEnabled(false);
+    Profiler::setThreadName("main");
+
+    // MAZE_RECORD=<ficheiro> grava o próximo jogo; MAZE_REPLAY=<ficheiro> volta a jogá-lo e sai
+    gRecordPath = getenv("MAZE_RECORD");
+    if (getenv("MAZE_REPLAY"))
+    {
+        gReplayResult.file = getenv("MAZE_REPLAY");
+        if (!gReplay.load(getenv("MAZE_REPLAY")))
+        {
+            std::cout << "[replay] erro a ler " << getenv("MAZE_REPLAY") << "\n";
+            return -1;
+        }
+        gReplayFast = getenv("MAZE_REPLAY_FAST") && strcmp(getenv("MAZE_REPLAY_FAST"), "0") != 0;
+        gRecordPath = nullptr;
+        std::cout << "[replay] " << gReplay.eventCount() << " eventos, " << gReplay.endTick() << " ticks"
+                  << (gReplayFast ? " (sem limite)" : "") << "\n";
+    }
+
+    // MAZE_FLYTHROUGH=15,21,101 percorre o caminho da solução de cada tamanho e sai
+    if (getenv("MAZE_FLYTHROUGH"))
+    {
+        if (getenv("MAZE_FLYTHROUGH_SEED"))
+            gFlySeed = (unsigned)strtoul(getenv("MAZE_FLYTHROUGH_SEED"), nullptr, 10);
+        if (getenv("MAZE_FLYTHROUGH_FRAMES"))
+            gFlyMaxFrames = atoi(getenv("MAZE_FLYTHROUGH_FRAMES"));
+
+        std::string sizes = getenv("MAZE_FLYTHROUGH");
+        size_t start = 0;
+        while (start < sizes.size())
+        {
+            size_t end = sizes.find(',', start);
+            if (end == std::string::npos)
+                end = sizes.size();
+            int size = atoi(sizes.substr(start, end - start).c_str());
+            if (size >= 5)
+            {
+                FlythroughRun run;
+                run.size = size | 1; // o carveMaze anda de 2 em 2: lado ímpar
+                run.seed = gFlySeed;
+                gFlyRuns.push_back(run);
+            }
+            start = end + 1;
+        }
+        gRecordPath = nullptr;
+        gReplayResult.file.clear();
+    }
+
+    // MAZE_HEADLESS=1280x720 (ou =1 para 1280x720): sem monitor nem janela visível, para
+    // benchmarks e replays em máquinas sem ecrã nem GPU (EGL ou OSMesa/llvmpipe)
+    int headlessW = 1280, headlessH = 720;
+    if (getenv("MAZE_HEADLESS") && *getenv("MAZE_HEADLESS") && strcmp(getenv("MAZE_HEADLESS"), "0") != 0)
+    {
+        gHeadless = true;
+        int w = 0, h = 0;
+        if (sscanf(getenv("MAZE_HEADLESS"), "%dx%d", &w, &h) == 2 && w > 0 && h > 0)
+        {
+            headlessW = w;
+            headlessH = h;
+        }
+    }
 
     // glfw: initialize and configure
     // ------------------------------
-    glfwInit();
+#if GLFW_VERSION_MAJOR > 3 || (GLFW_VERSION_MAJOR == 3 && GLFW_VERSION_MINOR >= 4)
+    if (gHeadless)
+        glfwInitHint(GLFW_PLATFORM, GLFW_PLATFORM_NULL); // nem X11 nem Wayland
+#endif
+    if (!glfwInit())
+    {
+        std::cout << "Failed to initialize GLFW" << std::endl;
+#if !(GLFW_VERSION_MAJOR > 3 || (GLFW_VERSION_MAJOR == 3 && GLFW_VERSION_MINOR >= 4))
+        // sem a plataforma nula (GLFW < 3.4) o GLFW precisa sempre de um servidor gráfico
+        if (gHeadless)
+            std::cout << "[headless] GLFW " << GLFW_VERSION_MAJOR << "." << GLFW_VERSION_MINOR
+                      << " não tem plataforma nula (precisa de 3.4): é preciso um display, "
+                         "por exemplo xvfb-run -a ./bin/maze"
+                      << std::endl;
+#endif
+        return -1;
+    }
     glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 3);
     glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 3);
     glfwWindowHint(GLFW_OPENGL_PROFILE, GLFW_OPENGL_CORE_PROFILE);
@@ -349,18 +1192,25 @@ int main()
     glfwWindowHint(GLFW_OPENGL_FORWARD_COMPAT, GL_TRUE);
 #endif
 
-    GLFWmonitor *monitor = glfwGetPrimaryMonitor();
-    const GLFWvidmode *mode = glfwGetVideoMode(monitor);
-
-    lastX = mode->width / 2.0f;
-    lastY = mode->height / 2.0f;
-
-    centerX = mode->width / 2.0f;
-    centerY = mode->height / 2.0f;
-
     // glfw window creation
     // --------------------
-    GLFWwindow *window = glfwCreateWindow(mode->width, mode->height, "Maze", NULL, NULL);
+    GLFWwindow *window = NULL;
+    if (gHeadless)
+    {
+        window = CreateHeadlessWindow(headlessW, headlessH);
+        lastX = headlessW / 2.0f;
+        lastY = headlessH / 2.0f;
+    }
+    else
+    {
+        GLFWmonitor *monitor = glfwGetPrimaryMonitor();
+        const GLFWvidmode *mode = glfwGetVideoMode(monitor);
+
+        lastX = mode->width / 2.0f;
+        lastY = mode->height / 2.0f;
+
+        window = glfwCreateWindow(mode->width, mode->height, "Maze", NULL, NULL);
+    }
     if (window == NULL)
     {
         std::cout << "Failed to create GLFW window" << std::endl;
@@ -373,11 +1223,16 @@ int main()
     glfwSetCursorPosCallback(window, cursor_pos_callback);
     glfwSetMouseButtonCallback(window, mouse_button_callback);
     glfwSetScrollCallback(window, scroll_callback);
+    glfwSetKeyCallback(window, key_callback);
 
-    glfwShowWindow(window);
-    glfwFocusWindow(window);
+    if (!gHeadless)
+    {
+        glfwShowWindow(window);
+        glfwFocusWindow(window);
+    }
 
     glfwSetFramebufferSizeCallback(window, framebuffer_size_callback);
+    glfwSetWindowRefreshCallback(window, window_refresh_callback);
 
     // tell GLFW to capture our mouse
     glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_HIDDEN);
@@ -396,26 +1251,86 @@ int main()
     // -----------------------------
     glEnable(GL_DEPTH_TEST);
 
+    StartupMark("janela + contexto GL");
+
+    // Texturas pré-comprimidas (make textures): BC1/BC3 com S3TC, senão ETC2; sem nenhum usa os PNG
+    // MAZE_NO_COOKED=1 ignora-as
+    if (!getenv("MAZE_NO_COOKED"))
+    {
+        bool bc = HasGLExtension("GL_EXT_texture_compression_s3tc");
+        bool etc2 = GLVersion.major > 4 || (GLVersion.major == 4 && GLVersion.minor >= 3) ||
+                    HasGLExtension("GL_ARB_ES3_compatibility");
+        SetCookedTextureFormats(bc, etc2);
+        std::cout << "Texturas comprimidas: BC " << (bc ? "sim" : "não") << ", ETC2 " << (etc2 ? "sim" : "não") << "\n";
+    }
+
+    // Assets: descodificação nas threads de trabalho, upload GL aqui (thread do contexto)
+    // MAZE_SYNC_LOAD=1 carrega tudo em sequência (para comparar tempos de arranque)
+    unsigned int loaderThreads = std::thread::hardware_concurrency();
+    if (loaderThreads == 0)
+        loaderThreads = 2;
+    if (loaderThreads > 8)
+        loaderThreads = 8;
+    if (getenv("MAZE_SYNC_LOAD"))
+        loaderThreads = 0;
+
+    AssetLoader loader(loaderThreads);
+    loader.logTimings = true;
+
     ///////////////////////////////////////////////////////////////////////////////////////////
-    if (!initAudio())
-        std::cout << "Áudio não iniciado (continuo sem som)\n";
+    static bool audioOk = false;
+    loader.run("audio (OpenAL + ./sounds/step.wav)", []
+               { audioOk = initAudio(); },
+               []
+               {
+                   if (!audioOk)
+                       std::cout << "Áudio não iniciado (continuo sem som)\n";
+               });
+
+    static bool meshOk = false;
+    loader.loadMesh(wall_mesh_File, [](DecodedMesh &mesh)
+                    { meshOk = transferDataToGPUMemory(mesh) != -1; });
+
+    prepareTextures(loader);
+
+    // UI: só regista as texturas; cada uma é carregada quando o seu ecrã aparece
+    // MAZE_TEX_BUDGET_MB=<n> limita a memória de GPU das texturas do UI
+    if (getenv("MAZE_TEX_BUDGET_MB"))
+        gAssets.setGpuBudget((size_t)atoi(getenv("MAZE_TEX_BUDGET_MB")) << 20);
+
+    texBg = gAssets.texture("./textures/wallpaper.png");
+    btnStart.tex = gAssets.texture("./textures/play.png");
+    btnExitMain.tex = gAssets.texture("./textures/exit1.png");
+
+    btnEasy.tex = gAssets.texture("./textures/easymode.png");
+    btnNormal.tex = gAssets.texture("./textures/normalmode.png");
+    btnHard.tex = gAssets.texture("./textures/hardmode.png");
+    btnExitMode.tex = gAssets.texture("./textures/exit2.png");
+
+    texVictory = gAssets.texture("./textures/winner.png");
+    btnExitVictory.tex = gAssets.texture("./textures/exit2.png");
+
+    // o menu principal é o primeiro ecrã -> descodificar já em paralelo
+    std::vector<TextureHandle> firstScreen;
+    ScreenTextures(state, firstScreen);
+    for (size_t i = 0; i < firstScreen.size(); i++)
+    {
+        gAssets.acquire(firstScreen[i]);
+        gAssets.prefetch(loader, firstScreen[i]);
+    }
 
-    // build and compile our shader zprogram
+    // build and compile our shader zprogram (enquanto os workers descodificam)
     // ------------------------------------
     Shader lightingShader("./shaders/2.1.basic_lighting.vs", "./shaders/2.1.basic_lighting.fs");
     Shader lampShader("./shaders/2.1.lamp.vs", "./shaders/2.1.lamp.fs");
 
-    if (transferDataToGPUMemory(gChoice) == -1)
-        return -1;
-
     setNormalMode();
     gChoice = 2;
     gDrunkMode = false;
 
-    prepareTextures();
-
     srand(time(NULL));
-    generateMaze();
+    generateMaze(BeginLevelArena());
+    BuildLevelWalls();
 
     Shader drunkShader("./shaders/postprocess.vs", "./shaders/drunk.fs");
 
@@ -444,19 +1359,22 @@ int main()
 
     Shader uiShader("./shaders/ui.vs", "./shaders/ui.fs");
 
-    texBg = LoadTextureRGBA("./textures/wallpaper.png");
-    btnStart.tex = LoadTextureRGBA("./textures/play.png");
-    btnExitMain.tex = LoadTextureRGBA("./textures/exit1.png");
+    StartupMark("shaders compilados + labirinto gerado");
 
-    btnEasy.tex = LoadTextureRGBA("./textures/easymode.png");
-    btnNormal.tex = LoadTextureRGBA("./textures/normalmode.png");
-    btnHard.tex = LoadTextureRGBA("./textures/hardmode.png");
-    btnExitMode.tex = LoadTextureRGBA("./textures/exit2.png");
+    // Hot-reload dos shaders: uma thread vigia ./shaders e o loop recompila o que mudou
+    // (desligado no executável com assets embutidos e com MAZE_NO_SHADER_RELOAD=1)
+    Shader *const shaders[] = {&lightingShader, &lampShader, &drunkShader, &uiShader};
+    const int shaderCount = sizeof(shaders) / sizeof(shaders[0]);
+    FileWatcher shaderWatcher;
+    if (!AssetsEmbedded() && !getenv("MAZE_NO_SHADER_RELOAD") && shaderWatcher.start("./shaders"))
+        std::cout << "[shaders] a vigiar ./shaders (hot-reload)\n";
 
-    texVictory = LoadTextureRGBA("./textures/winner.png");
-    btnExitVictory.tex = LoadTextureRGBA("./textures/exit2.png");
+    // esperar pelos uploads que ainda faltam
+    loader.finish();
+    if (!meshOk)
+        return -1;
 
-    CreateUIQuad();
+    StartupMark(loaderThreads ? "assets prontos (assíncrono)" : "assets prontos (sequencial)");
 
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
@@ -464,281 +1382,602 @@ int main()
     glfwGetFramebufferSize(window, &gWinW, &gWinH);
     BuildMenuLayout();
 
-    // render loop
-    // -----------
-    while (!glfwWindowShouldClose(window))
-    {
+    gShowHud = getenv("MAZE_HUD") && strcmp(getenv("MAZE_HUD"), "0") != 0;
+
+    // A partir daqui o contexto GL passa para a thread de render.
+    // A thread principal fica com os eventos GLFW e a de simulação publica, depois de cada
+    // conjunto de ticks, um FramePacket; o render desenha sempre o último publicado.
+    // ------------------------------------------------------------------------------------
+    std::atomic<bool> renderQuit(false);
+    GameState renderStartState = state;
+    unsigned renderStartLevel = gLevelSerial;
+    glfwMakeContextCurrent(NULL);
+
+    std::thread renderThread([&]()
+                             {
+        Profiler::setThreadName("render");
+        glfwMakeContextCurrent(window);
+        if (gReplayFast || !gFlyRuns.empty() || gHeadless)
+            glfwSwapInterval(0); // replay sem limite / benchmark / sem ecrã: sem esperar pelo vsync
+        OffscreenTarget offscreen;
+
+        // MAZE_CAPTURE=<pasta> grava os frames desenhados (PNG, ou MAZE_CAPTURE_FORMAT=raw),
+        // 1 em cada MAZE_CAPTURE_EVERY; a leitura é assíncrona (PBOs) e a escrita noutra thread
+        FrameCapture capture;
+        if (getenv("MAZE_CAPTURE"))
+        {
+            const char *fmt = getenv("MAZE_CAPTURE_FORMAT");
+            FrameCapture::Format format = fmt && strcmp(fmt, "raw") == 0 ? FrameCapture::RAW : FrameCapture::PNG;
+            int every = getenv("MAZE_CAPTURE_EVERY") ? atoi(getenv("MAZE_CAPTURE_EVERY")) : 1;
+            if (!capture.start(getenv("MAZE_CAPTURE"), format, every))
+                std::cout << "[capture] erro a abrir " << getenv("MAZE_CAPTURE") << "\n";
+        }
 
-        int newW, newH;
-        glfwGetFramebufferSize(window, &newW, &newH);
-        if (newW != gWinW || newH != gWinH)
+        // MAZE_TELEMETRY=<log.csv|log.json> e/ou MAZE_TELEMETRY_SOCKET=<caminho>: histogramas dos
+        // tempos de frame, com percentis no log a cada MAZE_TELEMETRY_PERIOD segundos
+        Telemetry telemetry;
+        if (getenv("MAZE_TELEMETRY") || getenv("MAZE_TELEMETRY_SOCKET"))
         {
-            gWinW = newW;
-            gWinH = newH;
-            BuildMenuLayout();
+            const char *logPath = getenv("MAZE_TELEMETRY") ? getenv("MAZE_TELEMETRY") : "";
+            const char *socketPath = getenv("MAZE_TELEMETRY_SOCKET") ? getenv("MAZE_TELEMETRY_SOCKET") : "";
+            double period = getenv("MAZE_TELEMETRY_PERIOD") ? atof(getenv("MAZE_TELEMETRY_PERIOD")) : 10.0;
+            size_t maxKB = getenv("MAZE_TELEMETRY_MAX_KB") ? strtoul(getenv("MAZE_TELEMETRY_MAX_KB"), nullptr, 10) : 1024;
+            if (!telemetry.start(logPath, socketPath, period, maxKB * 1024))
+                std::cout << "[telemetry] erro a abrir " << logPath << "\n";
         }
 
-        glfwGetFramebufferSize(window, &gWinW, &gWinH);
+        GameState shownState = renderStartState;
+        unsigned builtLevel = renderStartLevel;
+        int viewW = 0, viewH = 0;
+
+        // MAZE_MAX_FRAMES_IN_FLIGHT=<n> (0 = sem limite, deixa o driver decidir)
+        FrameLatency latency(getenv("MAZE_MAX_FRAMES_IN_FLIGHT") ? atoi(getenv("MAZE_MAX_FRAMES_IN_FLIGHT")) : 2);
+        unsigned lastSerial = 0;
+
+        // tempo de GPU por passagem (lido uns frames depois, sem esperar)
+        GpuTimer gpuTimer;
+        if (!gpuTimer.init())
+            std::cout << "[gpu] driver sem GL_TIMESTAMP, sem tempos de GPU\n";
+        const int gpuWalls = gpuTimer.addPass("walls (GPU)");
+        const int gpuFloor = gpuTimer.addPass("floor (GPU)");
+        const int gpuDrunk = gpuTimer.addPass("drunk pass (GPU)");
+        const int gpuMenu = gpuTimer.addPass("menu UI (GPU)");
+
+        // menu e HUD: todos os quads do frame num único flush
+        SpriteBatch uiBatch;
+        uiBatch.init();
+        PerfHud hud;
+        if (!hud.init(uiBatch, UI_LAYER_HUD))
+            std::cout << "[hud] erro a criar o atlas da fonte\n";
+        RenderStats lastStats = gRenderStats;
+        double lastSwapTime = 0.0;
+        bool lastWasReplay = false;
+        int flyRunShown = -1, flyFrames = 0;
+        double frameStart = 0.0;     // depois do limitador de frames em voo
+        bool idleSinceSwap = false;  // o render dormiu à espera de um pacote desde o último swap
+
+        // depois de cada swap: tempo de frame (HUD, replay, fly-through e telemetria) e o pacote que
+        // ficou no ecrã
+        auto framePresented = [&](const FramePacket &shown, double submitTime)
+        {
+            double now = glfwGetTime();
+            float ms = lastSwapTime > 0.0 ? (float)((now - lastSwapTime) * 1000.0) : 0.0f;
+            if (lastSwapTime > 0.0)
+            {
+                hud.addFrameTime(ms);
+                if (shown.replaying && lastWasReplay)
+                    gReplayResult.frameMs.push_back(ms);
+            }
+            lastSwapTime = now;
+            lastWasReplay = shown.replaying;
+
+            if (telemetry.active())
+            {
+                // GPU do frame cujas queries acabaram de chegar, só com os passes desse frame
+                // (-1 enquanto não houver um resultado completo)
+                float gpuMs = gpuTimer.resolvedFrameMs();
+                // o intervalo só conta entre frames seguidos, não o tempo parado do render a pedido
+                telemetry.recordFrame((float)((submitTime - frameStart) * 1000.0), gpuMs,
+                                      ms > 0.0f && !idleSinceSwap ? ms : -1.0f, (float)((now - submitTime) * 1000.0));
+            }
+            idleSinceSwap = false;
+
+            if (shown.flyRun >= 0)
+            {
+                // os primeiros frames de cada tamanho (nível novo, caches frias) não contam
+                if (shown.flyRun != flyRunShown)
+                {
+                    flyRunShown = shown.flyRun;
+                    flyFrames = 0;
+                }
+                FlythroughRun &run = gFlyRuns[shown.flyRun];
+                if (++flyFrames > FLY_WARMUP_FRAMES && ms > 0.0f)
+                {
+                    run.frameMs.push_back(ms);
+                    run.drawCalls += gRenderStats.drawCalls;
+                    run.triangles += gRenderStats.triangles;
+                }
+                // os tempos de GPU lidos agora são de GPU_TIMER_FRAMES frames atrás: só contam
+                // quando esse frame já era deste tamanho e já tinha passado o aquecimento
+                if (flyFrames - GPU_TIMER_FRAMES > FLY_WARMUP_FRAMES && gpuTimer.resolvedFrameMs() >= 0.0f)
+                {
+                    run.gpuFrames++;
+                    run.gpuPassNames.resize(gpuTimer.passCount());
+                    run.gpuPassMs.resize(gpuTimer.passCount(), 0.0);
+                    for (int p = 0; p < gpuTimer.passCount(); p++)
+                    {
+                        run.gpuPassNames[p] = gpuTimer.passName(p);
+                        if (gpuTimer.resolvedPassMs(p) > 0.0f)
+                            run.gpuPassMs[p] += gpuTimer.resolvedPassMs(p);
+                    }
+                }
+            }
+            gRenderedSerial.store(shown.serial);
+        };
+
+        // MAZE_ALWAYS_RENDER=1 desenha todos os frames, mesmo iguais (benchmarks)
+        const bool renderOnDemand = !getenv("MAZE_ALWAYS_RENDER");
+        bool interpDone = false; // o último frame já mostra a posição do último tick
+
+        // render loop
+        // -----------
+        while (!renderQuit.load())
+        {
+            bool fresh = gFrames.acquire();
+            const FramePacket &frame = gFrames.read();
+            if (frame.winW == 0)
+            {
+                // ainda nada publicado
+                gFrames.waitFresh(std::chrono::milliseconds(100));
+                continue;
+            }
+
+            bool shadersChanged = ReloadChangedShaders(shaderWatcher, shaders, shaderCount);
+
+            // Render a pedido: só se redesenha quando a simulação publica uma mudança, um shader
+            // muda, a interpolação ainda não chegou ao último tick ou há um efeito que depende
+            // do tempo (drunk.fs); com o HUD ligado refresca-se 4x por segundo. De resto fica o
+            // último frame no ecrã e a thread dorme até ao próximo pacote.
+            if (fresh)
+                interpDone = false;
+            bool animating = frame.replaying || frame.flyRun >= 0 || (frame.state == GameState::PLAYING && (frame.drunkMode || !interpDone));
+            bool hudDue = frame.showHud && glfwGetTime() - lastSwapTime >= 0.25;
+            if (renderOnDemand && !fresh && !shadersChanged && !animating && !hudDue)
+            {
+                // o último frame acaba agora, não quando se voltar a desenhar
+                latency.flush();
+                gFrames.waitFresh(std::chrono::milliseconds(250));
+                idleSinceSwap = true;
+                continue;
+            }
+
+            PROFILE_SCOPE("render frame");
+
+            // o carregamento de texturas e o hot-reload fazem binds por fora da cache
+            lastStats = gRenderStats;
+            ResetRenderStats();
+            InvalidateGLState();
+
+            {
+                PROFILE_SCOPE("frame limiter");
+                latency.beginFrame();
+            }
+            frameStart = glfwGetTime();
+            gpuTimer.beginFrame();
+            double inputTime = frame.serial != lastSerial ? frame.inputTime : 0.0;
+            lastSerial = frame.serial;
+
+            if (frame.winW != viewW || frame.winH != viewH)
+            {
+                viewW = frame.winW;
+                viewH = frame.winH;
+                glViewport(0, 0, viewW, viewH);
+                if (gHeadless)
+                {
+                    if (!offscreen.resize(viewW, viewH))
+                        std::cout << "[headless] FBO incompleto (" << viewW << "x" << viewH << ")\n";
+                    gPresentFBO = offscreen.fbo();
+                }
+            }
+
+            if (frame.state != shownState)
+            {
+                SwitchScreenTextures(shownState, frame.state);
+                shownState = frame.state;
+            }
 
-        if (state != GameState::PLAYING)
-        {
-            glfwSetCursorPosCallback(window, cursor_pos_callback);
-            glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_NORMAL);
+            if (frame.levelSerial != builtLevel)
+            {
+                PrepareLevelGL(frame);
+                InvalidateGLState();
+                builtLevel = frame.levelSerial;
+            }
 
-            glDisable(GL_DEPTH_TEST);
-            glClear(GL_COLOR_BUFFER_BIT);
+            if (frame.state != GameState::PLAYING)
+            {
+                {
+                    PROFILE_SCOPE("menu UI");
+                    GpuPassScope gpuPass(gpuTimer, gpuMenu);
+                    glBindFramebuffer(GL_FRAMEBUFFER, gPresentFBO);
+                    glDisable(GL_DEPTH_TEST);
+                    glClear(GL_COLOR_BUFFER_BIT);
+
+                    // fundo + botões do ecrã actual
+                    for (int i = 0; i < frame.quadCount; i++)
+                    {
+                        const Rect &r = frame.quads[i].r;
+                        uiBatch.addImage(r.x, r.y, r.w, r.h, gAssets.get(frame.quads[i].tex), frame.quads[i].layer);
+                    }
+                    if (frame.showHud)
+                        BuildPerfHud(hud, gpuTimer, lastStats);
+
+                    uiBatch.flush(uiShader, OrthoTopLeft((float)frame.winW, (float)frame.winH));
+                }
 
-            uiShader.use();
-            uiShader.setMat4("uProj", OrthoTopLeft((float)gWinW, (float)gWinH));
+                capture.captureFrame(gPresentFBO, viewW, viewH);
+                double submitTime = glfwGetTime();
+                {
+                    PROFILE_SCOPE("swap");
+                    glfwSwapBuffers(window);
+                }
+                framePresented(frame, submitTime);
+                latency.endFrame(inputTime, submitTime);
+                MarkFirstFrame();
+                continue; // não desenha o 3D
+            }
 
-            // background full-screen
-            Rect bg = {0, 0, (float)gWinW, (float)gWinH};
-            DrawRectUI(uiShader, bg, texBg);
+            // posição a desenhar: entre os dois últimos ticks, avançando com o tempo desde a publicação
+            float simAlpha = frame.simAlpha + (float)((glfwGetTime() - frame.time) / SIM_DT);
+            if (simAlpha > 1.0f)
+                simAlpha = 1.0f;
+            glm::vec3 renderPos = glm::mix(frame.prevPos, frame.pos, simAlpha);
+            interpDone = simAlpha >= 1.0f || frame.prevPos == frame.pos;
 
-            // botões / ecrãs
-            if (state == GameState::MENU_MAIN)
-            {
-                DrawRectUI(uiShader, btnStart.r, btnStart.tex);
-                DrawRectUI(uiShader, btnExitMain.r, btnExitMain.tex);
-            }
-            else if (state == GameState::MENU_MODE)
+            if (frame.drunkMode)
             {
-                DrawRectUI(uiShader, btnEasy.r, btnEasy.tex);
-                DrawRectUI(uiShader, btnNormal.r, btnNormal.tex);
-                DrawRectUI(uiShader, btnHard.r, btnHard.tex);
-                DrawRectUI(uiShader, btnExitMode.r, btnExitMode.tex);
+                // acompanha o tamanho da janela (o alvo do tamanho anterior volta ao pool)
+                createSceneFBO(frame.winW, frame.winH);
+                glBindFramebuffer(GL_FRAMEBUFFER, gSceneTarget.fbo);
             }
-            else if (state == GameState::VICTORY)
+            else
             {
-                // fundo é a imagem do WINNER
-                DrawRectUI(uiShader, bg, texVictory);
-                DrawRectUI(uiShader, btnExitVictory.r, btnExitVictory.tex);
+                glBindFramebuffer(GL_FRAMEBUFFER, gPresentFBO);
             }
 
-            glfwSwapBuffers(window);
-            glfwPollEvents();
-            continue; // não desenha o 3D
-        }
-        else
-        {
-            glfwSetCursorPosCallback(window, mouse_callback);
-            glfwSetInputMode(window, GLFW_CURSOR, GLFW_CURSOR_HIDDEN);
-            
-            // aqui fazes o teu render 3D normal (labirinto)
-        }
-
-        // per-frame time logic
-        // --------------------
-        float currentFrame = glfwGetTime();
-        deltaTime = currentFrame - lastFrame;
-        lastFrame = currentFrame;
+            glEnable(GL_DEPTH_TEST);
+            glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        // input
-        // -----
-        processInput(window);
+            // be sure to activate shader when setting uniforms/drawing objects
+            lightingShader.use();
+            // lightingShader.setVec3("objectColor", 1.0f, 0.5f, 0.31f);
+            lightingShader.setVec3("lightColor", 1.0f, 1.0f, 1.0f);
 
-        // Verifica se o jogador chegou ao fim do labirinto
-        // ( VER MELHOR )
-        int px = (int)floor(camera.Position.x / CELL_SIZE);
-        int pz = (int)floor(camera.Position.z / CELL_SIZE);
+            // flashlight attributes
+            lightingShader.setVec3("lightPos", renderPos);
+            lightingShader.setVec3("lightDir", frame.front);
+            lightingShader.setVec3("viewPos", renderPos);
 
-        if (pz == MAZE_H - 2 && px == MAZE_W - 1)
-        {
-            stopFootsteps();
-            state = GameState::VICTORY;
-            BuildMenuLayout();
-            continue; // vai já desenhar o UI no próximo ciclo
-        }
+            // flashlight is available or not
+            lightingShader.setBool("flashlightMode", frame.flashlightMode);
 
-        if (gDrunkMode)
-        {
-            glBindFramebuffer(GL_FRAMEBUFFER, sceneFBO);
-        }
-        else
-        {
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
-        }
+            // flashlight on/off
+            lightingShader.setBool("flashlightOn", frame.flashlightOn);
 
-        glEnable(GL_DEPTH_TEST);
-        glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            // Light Falloff
+            lightingShader.setFloat("constant", 1.0f);
+            lightingShader.setFloat("linear", 0.09f);
+            lightingShader.setFloat("quadratic", 0.032f);
 
-        // render
-        // ------
-        glClearColor(0.1f, 0.1f, 0.1f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+            lightingShader.setFloat("cutOff", cos(glm::radians(innerCutOff)));
+            lightingShader.setFloat("outerCutOff", cos(glm::radians(outerCutOff)));
 
-        // be sure to activate shader when setting uniforms/drawing objects
-        lightingShader.use();
-        // lightingShader.setVec3("objectColor", 1.0f, 0.5f, 0.31f);
-        lightingShader.setVec3("lightColor", 1.0f, 1.0f, 1.0f);
+            // view/projection transformations
+            glm::mat4 projection = glm::perspective(glm::radians(frame.zoom), (float)frame.winW / (float)frame.winH, 0.1f, 100.0f);
+            glm::mat4 view = glm::lookAt(renderPos, renderPos + frame.front, frame.up);
+            lightingShader.setMat4("projection", projection);
+            lightingShader.setMat4("view", view);
 
-        // flashlight attributes
-        lightingShader.setVec3("lightPos", camera.Position);
-        lightingShader.setVec3("lightDir", camera.Front);
-        lightingShader.setVec3("viewPos", camera.Position);
+            // render dos cubos (visible set do pacote)
+            //
+            {
+                PROFILE_SCOPE("walls");
+                GpuPassScope gpuPass(gpuTimer, gpuWalls);
+                GLBindVertexArray(wall_VAO);
+                GLBindTexture2D(0, wallTexture);
+                lightingShader.setInt("texture1", 0);
+
+                const ArenaArray<glm::vec3> &walls = *frame.walls;
+                for (size_t i = 0; i < walls.size(); i++)
+                {
+                    glm::mat4 model = glm::translate(glm::mat4(1.0f), walls[i]);
+                    lightingShader.setMat4("model", model);
+                    GLDrawTriangles(0, wall_vertexCount);
+                }
+            }
 
-        // flashlight is available or not
-        lightingShader.setBool("flashlightMode", flashlightMode);
+            // Render do chão
+            {
+                PROFILE_SCOPE("floor");
+                GpuPassScope gpuPass(gpuTimer, gpuFloor);
+                GLBindVertexArray(floor_VAO);
 
-        // flashlight on/off
-        lightingShader.setBool("flashlightOn", flashlightOn);
+                glm::mat4 model = glm::mat4(1.0f);
+                lightingShader.setMat4("model", model);
 
-        // Light Falloff
-        lightingShader.setFloat("constant", 1.0f);
-        lightingShader.setFloat("linear", 0.09f);
-        lightingShader.setFloat("quadratic", 0.032f);
+                GLBindTexture2D(1, floorTexture);
+                lightingShader.setInt("texture1", 1);
 
-        lightingShader.setFloat("cutOff", cos(glm::radians(innerCutOff)));
-        lightingShader.setFloat("outerCutOff", cos(glm::radians(outerCutOff)));
+                GLDrawTriangles(0, floor_vertexCount);
+            }
 
-        // view/projection transformations
-        glm::mat4 projection = glm::perspective(glm::radians(camera.Zoom), (float)gWinW / (float)gWinH, 0.1f, 100.0f);
-        glm::mat4 view = camera.GetViewMatrix();
-        lightingShader.setMat4("projection", projection);
-        lightingShader.setMat4("view", view);
+            if (frame.drunkMode)
+            {
+                PROFILE_SCOPE("drunk pass");
+                GpuPassScope gpuPass(gpuTimer, gpuDrunk);
+                glBindFramebuffer(GL_FRAMEBUFFER, gPresentFBO);
+                glDisable(GL_DEPTH_TEST);
+
+                drunkShader.use();
+                drunkShader.setInt("sceneTex", 0);
+                drunkShader.setFloat("time", (float)glfwGetTime());
+                drunkShader.setFloat("intensity", 1.0f); // 0.8 a 1.4
+
+                GLBindTexture2D(0, gSceneTarget.color);
+                GLBindVertexArray(quadVAO);
+                GLDrawTriangles(0, 6);
+            }
 
-        // world transformation
-        glm::mat4 model = glm::mat4(1.0f);
-        lightingShader.setMat4("model", model);
+            if (frame.showHud)
+            {
+                BuildPerfHud(hud, gpuTimer, lastStats);
+                uiBatch.flush(uiShader, OrthoTopLeft((float)frame.winW, (float)frame.winH));
+            }
 
-        // render dos cubos
-        //
-        glBindVertexArray(wall_VAO);
+            // glfw: swap buffers
+            // -------------------------------------------------------------------------------
+            capture.captureFrame(gPresentFBO, viewW, viewH);
+            double submitTime = glfwGetTime();
+            {
+                PROFILE_SCOPE("swap");
+                glfwSwapBuffers(window);
+            }
+            framePresented(frame, submitTime);
+            latency.endFrame(inputTime, submitTime);
+            MarkFirstFrame();
+        }
 
-        for (int z = 0; z < MAZE_H; z++)
+        // optional: de-allocate all resources once they've outlived their purpose:
+        // ------------------------------------------------------------------------
+        glDeleteVertexArrays(1, &wall_VAO);
+        glDeleteBuffers(1, &wall_VBO);
+        MemTrackFree(MEM_GL, MeshGpuBytes(wall_vertexCount));
+        glDeleteVertexArrays(1, &floor_VAO);
+        floor_buffer.shutdown();
+        glDeleteTextures(1, &wallTexture);
+        glDeleteTextures(1, &floorTexture);
+        MemTrackFree(MEM_GL, wallTextureBytes);
+        MemTrackFree(MEM_GL, floorTextureBytes);
+        ReleaseDrunkResources();
+        printf("[gl] render targets: %u criados, %u reutilizados; VBO do chão: %u alocações\n", gTargetPool.created(),
+               gTargetPool.reused(), floor_buffer.reallocations());
+        gTargetPool.clear();
+        gAssets.clear();
+        latency.clear();
+        capture.stop();
+        telemetry.stop();
+        offscreen.shutdown();
+        latency.printReport();
+
+        for (int p = 0; p < gpuTimer.passCount(); p++)
+            if (gpuTimer.passMs(p) > 0.0f)
+                printf("[gpu] %-18s %.3f ms\n", gpuTimer.passName(p), gpuTimer.passMs(p));
+        gpuTimer.shutdown();
+        hud.shutdown();
+        uiBatch.shutdown();
+
+        glfwMakeContextCurrent(NULL); });
+
+    // Simulação numa thread própria: ticks fixos de SIM_DT; em cada tick consome o input que
+    // chegou até ao instante do tick (pela ordem e com os timestamps) e depois publica o frame
+    // ------------------------------------------------------------------------------------
+    std::atomic<bool> simQuit(false);
+    std::thread simThread([&]()
+                          {
+        Profiler::setThreadName("simulation");
+        double nextTick = glfwGetTime();
+        ViewKey lastView = CurrentView();
+        if (!gReplayResult.file.empty())
+            StartReplay(window);
+        if (!gFlyRuns.empty())
+            RunFlythrough(window, simQuit);
+
+        while (!simQuit.load())
         {
-            for (int x = 0; x < MAZE_W; x++)
+            // replay sem limite: um tick por iteração, já
+            if (gReplaying && gReplayFast)
+                nextTick = glfwGetTime();
+
+            double now = glfwGetTime();
+            if (now < nextTick)
+            {
+                std::this_thread::sleep_for(std::chrono::duration<double>(nextTick - now));
+                continue;
+            }
+            // depois de um soluço simula no máximo SIM_MAX_FRAME (evita a espiral)
+            if (now - nextTick > SIM_MAX_FRAME)
+                nextTick = now - SIM_MAX_FRAME;
+
+            while (nextTick <= now)
             {
-                if (maze[z][x] == 1) // arbusto
+                InputEvent ev;
+                while (gInput.peek(ev) && ev.time <= nextTick)
+                {
+                    gInput.pop();
+                    // no replay o input ao vivo só serve para a janela (e ESC para sair)
+                    if (gReplaying && ev.type != InputEvent::RESIZE && ev.type != InputEvent::REFRESH &&
+                        !(ev.type == InputEvent::KEY && ev.code == GLFW_KEY_ESCAPE))
+                        continue;
+                    if (gRecorder.isOpen() && state == GameState::PLAYING)
+                        gRecorder.event(gGameTick, ev.time - gGameStartTime, ev);
+                    HandleInput(ev, window);
+                }
+
+                if (gReplaying)
                 {
-                    glm::mat4 model = glm::mat4(1.0f);
+                    while (gReplay.nextEvent(gGameTick, ev))
+                    {
+                        // a janela é a de agora; o ESC que acabou a gravação é o fim do replay
+                        if (ev.type == InputEvent::RESIZE || ev.type == InputEvent::REFRESH ||
+                            (ev.type == InputEvent::KEY && ev.code == GLFW_KEY_ESCAPE))
+                            continue;
+                        ev.time = glfwGetTime();
+                        HandleInput(ev, window);
+                    }
+                }
 
-                    model = glm::translate(model, glm::vec3(
-                                                      (x + 0.5f) * CELL_SIZE,
-                                                      0.0f,
-                                                      (z + 0.5f) * CELL_SIZE));
+                // input + movimento + colisões
+                if (state == GameState::PLAYING && SimulationTick(window))
+                {
+                    stopFootsteps();
+                    SetState(GameState::VICTORY);
+                }
+                memset(gKeyTapped, 0, sizeof(gKeyTapped));
 
-                    lightingShader.setMat4("model", model);
-                    glActiveTexture(GL_TEXTURE0);
-                    glBindTexture(GL_TEXTURE_2D, wallTexture);
-                    lightingShader.setInt("texture1", 0);
-                    glDrawArrays(GL_TRIANGLES, 0, wall_vertices.size());
+                if (state == GameState::PLAYING)
+                {
+                    SampleReplayCamera();
+                    gGameTick++;
                 }
-            }
-        }
+                if (gReplaying && (state != GameState::PLAYING || gGameTick >= gReplay.endTick()))
+                    FinishReplay(window, true);
 
-        // Render do chão
-        glBindVertexArray(floor_VAO);
+                lastTickTime = nextTick;
+                nextTick += SIM_DT;
+            }
 
-        model = glm::mat4(1.0f);
-        lightingShader.setMat4("model", model);
+            // só se publica o que mudou (o render só redesenha pacotes novos)
+            ViewKey view = CurrentView();
+            bool changed = gViewDirty || gReplaying || !(view == lastView);
+            if (changed)
+            {
+                PublishFrame();
+                lastView = view;
+                gViewDirty = false;
+            }
 
-        glActiveTexture(GL_TEXTURE1);
-        glBindTexture(GL_TEXTURE_2D, floorTexture);
-        lightingShader.setInt("texture1", 1);
+            // replay sem limite: esperar que o render apresente este tick (um frame por tick)
+            if (gReplaying && gReplayFast)
+                while (gRenderedSerial.load() < gFrameSerial && !simQuit.load())
+                    std::this_thread::yield();
 
-        glDrawArrays(GL_TRIANGLES, 0, (GLsizei)floor_vertices.size());
+            if (gTraceRequested)
+            {
+                gTraceRequested = false;
+                DumpTrace(nullptr);
+            }
 
-        if (gDrunkMode)
-        {
-            glBindFramebuffer(GL_FRAMEBUFFER, 0);
-            glDisable(GL_DEPTH_TEST);
+            // nada mudou e nenhuma tecla em baixo (jogador parado ou menu): dormir até chegar
+            // input em vez de fazer ticks a 120 Hz; os ticks perdidos não se recuperam
+            if (!changed && (state != GameState::PLAYING || !AnyKeyDown()))
+            {
+                InputEvent ev;
+                if (!gInput.peek(ev))
+                    WaitForInput(std::chrono::milliseconds(250), simQuit);
+                nextTick = glfwGetTime();
+            }
+        } });
 
-            drunkShader.use();
-            drunkShader.setInt("sceneTex", 0);
-            drunkShader.setFloat("time", (float)glfwGetTime());
-            drunkShader.setFloat("intensity", 1.0f); // 0.8 a 1.4
+    // Thread principal: só eventos GLFW (os callbacks põem-nos na fila) e o modo do cursor
+    // ------------------------------------------------------------------------------------
+    bool cursorCaptured = false;
+    ApplyCursorMode(window, cursorCaptured);
 
-            glActiveTexture(GL_TEXTURE0);
-            glBindTexture(GL_TEXTURE_2D, sceneColorTex);
+    while (!glfwWindowShouldClose(window))
+    {
+        // glfw: poll IO events (keys pressed/released, mouse moved etc.)
+        // a plataforma nula (headless) não espera por eventos: só se vê se a janela fechou
+        if (gHeadless)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            glfwPollEvents();
+        }
+        else
+            glfwWaitEvents();
 
-            glBindVertexArray(quadVAO);
-            glDrawArrays(GL_TRIANGLES, 0, 6);
-            glBindVertexArray(0);
+        bool wantCaptured = gCursorCaptured.load();
+        if (wantCaptured != cursorCaptured)
+        {
+            ApplyCursorMode(window, wantCaptured);
+            cursorCaptured = wantCaptured;
         }
+    }
+
+    simQuit = true;
+    WakeSimulation();
+    simThread.join();
+    renderQuit = true;
+    renderThread.join();
 
-        // glfw: swap buffers and poll IO events (keys pressed/released, mouse moved etc.)
-        // -------------------------------------------------------------------------------
-        glfwSwapBuffers(window);
-        glfwPollEvents();
+    gRecorder.close(gGameTick);
+    if (!gReplayResult.file.empty())
+    {
+        // replay interrompido (janela fechada / ESC): estatísticas do que correu
+        if (gReplaying)
+            FinishReplay(window, false);
+        mkdir("./outputs", 0755);
+        const char *report = getenv("MAZE_REPLAY_JSON") ? getenv("MAZE_REPLAY_JSON") : "./outputs/replay.json";
+        if (WriteReplayReport(report, gReplayResult))
+            std::cout << "[replay] estatísticas em " << report << "\n";
+    }
+    if (!gFlyRuns.empty())
+    {
+        mkdir("./outputs", 0755);
+        const char *report = getenv("MAZE_FLYTHROUGH_JSON") ? getenv("MAZE_FLYTHROUGH_JSON") : "./outputs/flythrough.json";
+        if (WriteFlythroughReport(report, gFlyRuns))
+            std::cout << "[flythrough] estatísticas em " << report << "\n";
     }
+    if (gInputDropped.load())
+        std::cout << "[input] " << gInputDropped.load() << " eventos perdidos (fila cheia)\n";
+    shaderWatcher.stop();
 
-    // optional: de-allocate all resources once they've outlived their purpose:
-    // ------------------------------------------------------------------------
-    glDeleteVertexArrays(1, &wall_VAO);
-    glDeleteBuffers(1, &wall_VBO);
-    glDeleteVertexArrays(1, &floor_VAO);
-    glDeleteBuffers(1, &floor_VBO);
+    if (getenv("MAZE_TRACE"))
+        DumpTrace(getenv("MAZE_TRACE"));
 
     // glfw: terminate, clearing all previously allocated GLFW resources.
     // ------------------------------------------------------------------
     glfwTerminate();
     shutdownAudio();
+
+    // o nível actual é global e os pacotes seguram a sua arena: sem isto apareceria como fuga
+    gFrames.clear();
+    gLevelWalls.reset();
+    gLevelArena.reset();
+    gLevelArenas.clear();
+    maze.clear();
+    if (MemLeakReport(stdout))
+        std::cout << "[mem] memória por libertar no fim (ver acima)\n";
     return 0;
 }
 
 // Funções
 //
 
-int loadMeshFromFile(char obj_file[], std::vector<float> &bufferData, std::vector<glm::vec3> &vertices, std::vector<glm::vec2> &uvs, std::vector<glm::vec3> &normals)
+int transferDataToGPUMemory(DecodedMesh &wallMesh)
 {
-    if (!loadOBJ(obj_file, vertices, uvs, normals))
-    {
-        std::cout << "Failed to load OBJ file!" << std::endl;
+    // Wall (já descodificada por um worker)
+    if (wallMesh.vertices.empty())
         return -1;
-    }
-
-    // Store data in the buffer
-    for (size_t i = 0; i < vertices.size(); ++i)
-    {
-        // Add vertex position
-        bufferData.push_back(vertices[i].x);
-        bufferData.push_back(vertices[i].y);
-        bufferData.push_back(vertices[i].z);
-
-        // Add normals (if they exist)
-        if (i < normals.size())
-        {
-            bufferData.push_back(normals[i].x);
-            bufferData.push_back(normals[i].y);
-            bufferData.push_back(normals[i].z);
-        }
-        else
-        {
-            bufferData.push_back(0.0f);
-            bufferData.push_back(0.0f);
-            bufferData.push_back(0.0f);
-        }
-
-        // Add UV coordinates
-        if (i < uvs.size())
-        {
-            bufferData.push_back(uvs[i].x);
-            bufferData.push_back(uvs[i].y);
-        }
-        else
-        {
-            bufferData.push_back(0.0f);
-            bufferData.push_back(0.0f);
-        }
-    }
 
-    return 0;
-}
-
-int transferDataToGPUMemory(int choice)
-{
-    // Wall
-    if (loadMeshFromFile(wall_mesh_File, wall_bufferData, wall_vertices, wall_uvs, wall_normals) == -1)
-        return -1;
+    wall_vertexCount = (GLsizei)wallMesh.vertices.size();
 
     // configure the deer's VAO (and VBO)
     glGenVertexArrays(1, &wall_VAO);
     glGenBuffers(1, &wall_VBO);
 
     glBindBuffer(GL_ARRAY_BUFFER, wall_VBO);
-    glBufferData(GL_ARRAY_BUFFER, wall_bufferData.size() * sizeof(float), wall_bufferData.data(), GL_DYNAMIC_DRAW);
+    glBufferData(GL_ARRAY_BUFFER, wallMesh.bufferData.size() * sizeof(float), wallMesh.bufferData.data(), GL_STATIC_DRAW);
+    MemTrackAlloc(MEM_GL, MeshGpuBytes(wall_vertexCount));
 
     glBindVertexArray(wall_VAO);
 
@@ -753,36 +1992,23 @@ int transferDataToGPUMemory(int choice)
     glEnableVertexAttribArray(2);
 
     // Floor
-    generateFloor(choice);
+    generateFloor(MAZE_W, MAZE_H);
     return 0;
 }
 
-void generateFloor(int choice)
+void generateFloor(int mazeW, int mazeH)
 {
     std::cout << "Generating scene floor\n";
 
-    float size;
-
-    switch (choice)
-    {
-    case 1:
-        size = 16.0f;
-        break;
-    case 2:
-        size = 21.0f;
-        break;
-    case 3:
-        size = 21.0f;
-        break;
-    default:
-        size = 16.0f;
-        break;
-    }
+    // o labirinto todo mais uma margem à volta (a entrada e a saída ficam na borda);
+    // antes do primeiro nível o tamanho ainda não existe e fica o do modo normal
+    if (mazeW <= 0 || mazeH <= 0)
+        mazeW = mazeH = 21;
 
     float x0 = -2.0f;
     float z0 = -2.0f;
-    float x1 = size;
-    float z1 = size;
+    float x1 = (mazeW + 1) * CELL_SIZE;
+    float z1 = (mazeH + 1) * CELL_SIZE;
 
     float uMax = (x1 - x0) / CELL_SIZE; // quantas “células” o chão tem em X
     float vMax = (z1 - z0) / CELL_SIZE; // quantas “células” o chão tem em Z
@@ -848,137 +2074,94 @@ void generateFloor(int choice)
         }
     }
 
-    // Gerar VAO e VBO (uma vez)
-    glGenVertexArrays(1, &floor_VAO);
-    glGenBuffers(1, &floor_VBO);
+    // VAO e VBO criados no primeiro jogo; depois os vértices são reescritos no mesmo buffer
+    bool firstFloor = floor_VAO == 0;
+    if (firstFloor)
+        glGenVertexArrays(1, &floor_VAO);
 
     glBindVertexArray(floor_VAO);
-    glBindBuffer(GL_ARRAY_BUFFER, floor_VBO);
-    glBufferData(GL_ARRAY_BUFFER, floor_bufferData.size() * sizeof(float), floor_bufferData.data(), GL_STATIC_DRAW);
+    floor_buffer.upload(GL_ARRAY_BUFFER, floor_bufferData.data(), floor_bufferData.size() * sizeof(float));
+    floor_vertexCount = (GLsizei)floor_vertices.size();
 
-    // STRIDE: 8 floats por vértice
-    GLsizei stride = 8 * sizeof(float);
+    // o layout só se define uma vez: o buffer mantém o nome, o VAO continua a apontá-lo
+    if (firstFloor)
+    {
+        // STRIDE: 8 floats por vértice
+        GLsizei stride = 8 * sizeof(float);
 
-    // ---------- POSIÇÃO ----------
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void *)0);
-    glEnableVertexAttribArray(0);
+        // ---------- POSIÇÃO ----------
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, stride, (void *)0);
+        glEnableVertexAttribArray(0);
 
-    // ---------- NORMAL ----------
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void *)(3 * sizeof(float)));
-    glEnableVertexAttribArray(1);
+        // ---------- NORMAL ----------
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, stride, (void *)(3 * sizeof(float)));
+        glEnableVertexAttribArray(1);
 
-    // ---------- UV ----------
-    glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void *)(6 * sizeof(float)));
-    glEnableVertexAttribArray(2);
+        // ---------- UV ----------
+        glVertexAttribPointer(2, 2, GL_FLOAT, GL_FALSE, stride, (void *)(6 * sizeof(float)));
+        glEnableVertexAttribArray(2);
+    }
 
     glBindVertexArray(0);
+
+    // já está na GPU: libertar as cópias em CPU
+    MeshVector<glm::vec3>().swap(floor_vertices);
+    MeshVector<glm::vec2>().swap(floor_uvs);
+    MeshVector<glm::vec3>().swap(floor_normals);
+    MeshVector<float>().swap(floor_bufferData);
 }
 
-void prepareTextures()
+void prepareTextures(AssetLoader &loader)
 {
     // Wall
     std::cout << "Loading wall texture...\n";
 
-    glGenTextures(1, &wallTexture);
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, wallTexture);
-
-    // Wrapping / filtering
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    // Flip (Blender compatibility)
-    stbi_set_flip_vertically_on_load(true);
-
-    wallData = stbi_load(wall_texture_File, &wallWidth, &wallHeight, &wallNrChannels, 0);
-
-    if (wallData)
-    {
-        GLenum format;
-        if (wallNrChannels == 1)
-            format = GL_RED;
-        else if (wallNrChannels == 3)
-            format = GL_RGB;
-        else if (wallNrChannels == 4)
-            format = GL_RGBA;
-
-        glTexImage2D(GL_TEXTURE_2D, 0, format, wallWidth, wallHeight, 0, format, GL_UNSIGNED_BYTE, wallData);
-        glGenerateMipmap(GL_TEXTURE_2D);
-    }
-    else
-    {
-        std::cout << "Failed to load wall texture\n";
-    }
+    loader.loadImage(wall_texture_File, 0, [](DecodedImage &img)
+                     {
+        wallWidth = img.width;
+        wallHeight = img.height;
+        wallNrChannels = img.channels;
 
-    stbi_image_free(wallData);
+        wallTexture = UploadTexture(img, GL_REPEAT, true);
+        wallTextureBytes = wallTexture ? TextureGpuBytes(img, true) : 0;
+        MemTrackAlloc(MEM_GL, wallTextureBytes);
+        if (!wallTexture)
+            std::cout << "Failed to load wall texture\n"; });
 
     // Floor
     std::cout << "Loading floor texture...\n";
 
-    glGenTextures(1, &floorTexture);
-    glActiveTexture(GL_TEXTURE1);
-    glBindTexture(GL_TEXTURE_2D, floorTexture);
-
-    // Wrapping / filtering
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_REPEAT);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    // Flip (Blender compatibility)
-    stbi_set_flip_vertically_on_load(true);
-
-    floorData = stbi_load(floor_texture_File, &floorWidth, &floorHeight, &floorNrChannels, 0);
-
-    if (floorData)
-    {
-        GLenum format;
-        if (floorNrChannels == 1)
-            format = GL_RED;
-        else if (floorNrChannels == 3)
-            format = GL_RGB;
-        else if (floorNrChannels == 4)
-            format = GL_RGBA;
-
-        glTexImage2D(GL_TEXTURE_2D, 0, format, floorWidth, floorHeight, 0, format, GL_UNSIGNED_BYTE, floorData);
-        glGenerateMipmap(GL_TEXTURE_2D);
-    }
-    else
-    {
-        std::cout << "Failed to load floor texture\n";
-    }
-
-    stbi_image_free(floorData);
+    loader.loadImage(floor_texture_File, 0, [](DecodedImage &img)
+                     {
+        floorWidth = img.width;
+        floorHeight = img.height;
+        floorNrChannels = img.channels;
+
+        floorTexture = UploadTexture(img, GL_REPEAT, true);
+        floorTextureBytes = floorTexture ? TextureGpuBytes(img, true) : 0;
+        MemTrackAlloc(MEM_GL, floorTextureBytes);
+        if (!floorTexture)
+            std::cout << "Failed to load floor texture\n"; });
 }
 
 // process all input: query GLFW whether relevant keys are pressed/released this frame and react accordingly
 // ---------------------------------------------------------------------------------------------------------
 void processInput(GLFWwindow *window)
 {
-    static bool fPressedLastFrame = false;
-    static bool lPressedLastFrame = false;
+    PROFILE_SCOPE("processInput");
 
-    bool wantMove =
-        glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS ||
-        glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS ||
-        glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS ||
-        glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS;
-
-    if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS)
-        glfwSetWindowShouldClose(window, true);
+    bool wantMove = KeyDown(GLFW_KEY_W) || KeyDown(GLFW_KEY_A) || KeyDown(GLFW_KEY_S) || KeyDown(GLFW_KEY_D);
 
     glm::vec3 oldPos = camera.Position;
 
     // mover (WASD)
-    if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS)
+    if (KeyDown(GLFW_KEY_W))
         camera.ProcessKeyboard(FORWARD, deltaTime, fixY);
-    if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS)
+    if (KeyDown(GLFW_KEY_S))
         camera.ProcessKeyboard(BACKWARD, deltaTime, fixY);
-    if (glfwGetKey(window, GLFW_KEY_A) == GLFW_PRESS)
+    if (KeyDown(GLFW_KEY_A))
         camera.ProcessKeyboard(LEFT, deltaTime, fixY);
-    if (glfwGetKey(window, GLFW_KEY_D) == GLFW_PRESS)
+    if (KeyDown(GLFW_KEY_D))
         camera.ProcessKeyboard(RIGHT, deltaTime, fixY);
 
     glm::vec3 target = camera.Position;
@@ -999,35 +2182,26 @@ void processInput(GLFWwindow *window)
     else
         stopFootsteps();
 
-    bool lPressed = (glfwGetKey(window, GLFW_KEY_L) == GLFW_PRESS); // Ativar/desativar o filtro
-    if (lPressed && !lPressedLastFrame)
-        fixY = !fixY;
-    lPressedLastFrame = lPressed;
+    // (L, F e ESC são tratados no evento da tecla, ver HandleInput)
 
-    if (glfwGetKey(window, GLFW_KEY_E) == GLFW_PRESS)
+    if (KeyDown(GLFW_KEY_E))
         camera.ProcessKeyboard(UP, deltaTime, fixY);
-    if (glfwGetKey(window, GLFW_KEY_Q) == GLFW_PRESS)
+    if (KeyDown(GLFW_KEY_Q))
         camera.ProcessKeyboard(DOWN, deltaTime, fixY);
 
-    if (glfwGetKey(window, GLFW_KEY_M) == GLFW_PRESS)
+    if (KeyDown(GLFW_KEY_M))
         increaseArrowSense();
-    if (glfwGetKey(window, GLFW_KEY_N) == GLFW_PRESS)
+    if (KeyDown(GLFW_KEY_N))
         decreaseArrowSense();
 
-    if (glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS)
+    if (KeyDown(GLFW_KEY_UP))
         moveCamera(1);
-    if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS)
+    if (KeyDown(GLFW_KEY_DOWN))
         moveCamera(2);
-    if (glfwGetKey(window, GLFW_KEY_LEFT) == GLFW_PRESS)
+    if (KeyDown(GLFW_KEY_LEFT))
         moveCamera(3);
-    if (glfwGetKey(window, GLFW_KEY_RIGHT) == GLFW_PRESS)
+    if (KeyDown(GLFW_KEY_RIGHT))
         moveCamera(4);
-
-    // Flashlight
-    bool fPressed = (glfwGetKey(window, GLFW_KEY_F) == GLFW_PRESS); // Ativar/desativar o filtro
-    if (fPressed && !fPressedLastFrame)
-        flashlightOn = !flashlightOn;
-    fPressedLastFrame = fPressed;
 }
 
 // glfw: whenever the window size changed (by OS or user resize) this callback function executes
@@ -1036,40 +2210,32 @@ void framebuffer_size_callback(GLFWwindow *window, int width, int height)
 {
     // make sure the viewport matches the new window dimensions; note that width and
     // height will be significantly larger than specified on retina displays.
-    glViewport(0, 0, width, height);
+    // (o layout do menu é refeito na simulação e o glViewport na thread de render)
+    PushInput(InputEvent::RESIZE, 0, 0, width, height);
 }
 
-// glfw: whenever the mouse moves, this callback is called
-// -------------------------------------------------------
-void mouse_callback(GLFWwindow *window, double xpos, double ypos)
+// janela exposta / danificada: o conteúdo tem de ser redesenhado mesmo sem mudanças no menu
+void window_refresh_callback(GLFWwindow *window)
 {
-    if (firstMouse)
-    {
-        lastX = xpos;
-        lastY = ypos;
-        firstMouse = false;
-    }
-
-    float xoffset = (xpos - lastX) * mouse_sense;
-    float yoffset = (lastY - ypos) * mouse_sense; // reversed since y-coordinates go from bottom to top
-
-    lastX = xpos;
-    lastY = ypos;
-
-    camera.ProcessMouseMovement(xoffset, yoffset);
-
-    glfwSetCursorPos(window, centerX, centerY);
+    PushInput(InputEvent::REFRESH, 0, 0, 0.0, 0.0);
 }
 
 // glfw: whenever the mouse scroll wheel scrolls, this callback is called
 // ----------------------------------------------------------------------
 void scroll_callback(GLFWwindow *window, double xoffset, double yoffset)
 {
-    camera.ProcessMouseScroll(yoffset);
+    PushInput(InputEvent::SCROLL, 0, 0, xoffset, yoffset);
+}
+
+void key_callback(GLFWwindow *window, int key, int scancode, int action, int mods)
+{
+    if (action != GLFW_REPEAT)
+        PushInput(InputEvent::KEY, key, action, 0.0, 0.0);
 }
 
 void moveCamera(int direction)
 {
+    float step = arrow_sense * ARROW_REF_RATE * deltaTime;
     switch (direction)
     {
         /*
@@ -1079,16 +2245,16 @@ void moveCamera(int direction)
     4 -> direita
     */
     case 1:
-        camera.ProcessMouseMovement(0.0f, arrow_sense);
+        camera.ProcessMouseMovement(0.0f, step);
         break;
     case 2:
-        camera.ProcessMouseMovement(0.0f, -arrow_sense);
+        camera.ProcessMouseMovement(0.0f, -step);
         break;
     case 3:
-        camera.ProcessMouseMovement(-arrow_sense, 0.0f);
+        camera.ProcessMouseMovement(-step, 0.0f);
         break;
     case 4:
-        camera.ProcessMouseMovement(arrow_sense, 0.0f);
+        camera.ProcessMouseMovement(step, 0.0f);
         break;
 
     default:
@@ -1098,169 +2264,39 @@ void moveCamera(int direction)
 
 void increaseArrowSense()
 {
-    arrow_sense += 0.5f;
+    arrow_sense += 0.5f * ARROW_REF_RATE * deltaTime;
 }
 void decreaseArrowSense()
 {
-    arrow_sense -= 0.5f;
+    arrow_sense -= 0.5f * ARROW_REF_RATE * deltaTime;
 
     if (arrow_sense <= 0.0f)
         arrow_sense = 0.5f;
 }
 
-// Gerar labirinto
-//
-
-void carveMaze(int x, int z)
-{
-    static int dirs[4][2] = {
-        {1, 0},  // direita
-        {-1, 0}, // esquerda
-        {0, 1},  // baixo
-        {0, -1}  // cima
-    };
-
-    // baralhar direções
-    for (int i = 0; i < 4; i++)
-    {
-        int r = rand() % 4;
-        std::swap(dirs[i], dirs[r]);
-    }
-
-    for (int i = 0; i < 4; i++)
-    {
-        int nx = x + dirs[i][0] * 2;
-        int nz = z + dirs[i][1] * 2;
-
-        if (nx > 0 && nz > 0 && nx < MAZE_W - 1 && nz < MAZE_H - 1)
-        {
-            if (maze[nz][nx] == 1)
-            {
-                maze[z + dirs[i][1]][x + dirs[i][0]] = 0;
-                maze[nz][nx] = 0;
-                carveMaze(nx, nz);
-            }
-        }
-    }
-}
-
-void generateMaze()
-{
-    maze.resize(MAZE_H, std::vector<int>(MAZE_W, 1));
-
-    for (int z = 0; z < MAZE_H; z++)
-        for (int x = 0; x < MAZE_W; x++)
-            maze[z][x] = 1;
-
-    maze[1][1] = 0;
-    carveMaze(1, 1);
-
-    for (int x = 0; x < MAZE_W; x++)
-    {
-        maze[0][x] = 1;
-        maze[MAZE_H - 1][x] = 1;
-    }
-
-    for (int z = 0; z < MAZE_H; z++)
-    {
-        maze[z][0] = 1;
-        maze[z][MAZE_W - 1] = 1;
-    }
-
-    maze[1][0] = 0;
-    maze[1][1] = 0;
-
-    int exitZ = MAZE_H - 2;
-
-    maze[exitZ][MAZE_W - 2] = 0;
-    maze[exitZ][MAZE_W - 1] = 0;
-}
-
-// Função de colisão
-//
-static inline float clampf(float v, float a, float b) { return (v < a) ? a : (v > b) ? b
-                                                                                     : v; }
-
-bool checkCollision(glm::vec3 pos)
-{
-    const float r = PLAYER_RADIUS;
-    const float r2 = r * r;
-
-    // limites do mundo
-    const float minWorldX = 0.0f;
-    const float minWorldZ = 0.0f;
-    const float maxWorldX = MAZE_W * CELL_SIZE;
-    const float maxWorldZ = MAZE_H * CELL_SIZE;
-
-    if (pos.x - r < minWorldX || pos.x + r > maxWorldX ||
-        pos.z - r < minWorldZ || pos.z + r > maxWorldZ)
-        return true;
-
-    int cx = (int)floor(pos.x / CELL_SIZE);
-    int cz = (int)floor(pos.z / CELL_SIZE);
-
-    for (int dz = -1; dz <= 1; dz++)
-    {
-        for (int dx = -1; dx <= 1; dx++)
-        {
-            int mx = cx + dx;
-            int mz = cz + dz;
-
-            if (mx < 0 || mx >= MAZE_W || mz < 0 || mz >= MAZE_H)
-                continue;
-
-            if (maze[mz][mx] != 1)
-                continue;
-
-            float minX = mx * CELL_SIZE;
-            float maxX = minX + CELL_SIZE;
-            float minZ = mz * CELL_SIZE;
-            float maxZ = minZ + CELL_SIZE;
-
-            float closestX = clampf(pos.x, minX, maxX);
-            float closestZ = clampf(pos.z, minZ, maxZ);
-
-            float dxp = pos.x - closestX;
-            float dzp = pos.z - closestZ;
-
-            if ((dxp * dxp + dzp * dzp) < r2)
-                return true;
-        }
-    }
-    return false;
-}
-
 // Som
 // FUTURO: COLOCAR SOM DA LATERNA
 //
 bool loadWavToOpenAL(const char *filename, ALuint &outBuffer)
 {
-    SF_INFO sfinfo;
-    SNDFILE *sndfile = sf_open(filename, SFM_READ, &sfinfo);
-    if (!sndfile)
-    {
-        std::cout << "Erro a abrir som: " << filename << "\n";
+    DecodedSound sound;
+    if (!DecodeWav(filename, sound))
         return false;
-    }
-
-    std::vector<short> samples(sfinfo.frames * sfinfo.channels);
-    sf_readf_short(sndfile, samples.data(), sfinfo.frames);
-    sf_close(sndfile);
 
     ALenum format;
-    if (sfinfo.channels == 1)
+    if (sound.channels == 1)
         format = AL_FORMAT_MONO16;
-    else if (sfinfo.channels == 2)
+    else if (sound.channels == 2)
         format = AL_FORMAT_STEREO16;
     else
     {
-        std::cout << "Formato WAV não suportado (channels=" << sfinfo.channels << ")\n";
+        std::cout << "Formato WAV não suportado (channels=" << sound.channels << ")\n";
         return false;
     }
 
     alGenBuffers(1, &outBuffer);
-    alBufferData(outBuffer, format, samples.data(),
-                 (ALsizei)(samples.size() * sizeof(short)), sfinfo.samplerate);
+    alBufferData(outBuffer, format, sound.samples.data(),
+                 (ALsizei)(sound.samples.size() * sizeof(short)), sound.sampleRate);
 
     return true;
 }
@@ -1329,30 +2365,18 @@ void stopFootsteps()
 
 // Bebado
 //
+// alvo da cena com o tamanho pedido: o actual se já tiver esse tamanho, senão um do pool
 void createSceneFBO(int w, int h)
 {
-    if (sceneFBO == 0)
-        glGenFramebuffers(1, &sceneFBO);
-    glBindFramebuffer(GL_FRAMEBUFFER, sceneFBO);
-
-    if (sceneColorTex == 0)
-        glGenTextures(1, &sceneColorTex);
-    glBindTexture(GL_TEXTURE_2D, sceneColorTex);
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGB, w, h, 0, GL_RGB, GL_UNSIGNED_BYTE, nullptr);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    glFramebufferTexture2D(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, sceneColorTex, 0);
-
-    if (sceneRBO == 0)
-        glGenRenderbuffers(1, &sceneRBO);
-    glBindRenderbuffer(GL_RENDERBUFFER, sceneRBO);
-    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, w, h);
-    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, sceneRBO);
+    if (w <= 0 || h <= 0 || (gSceneTarget.valid() && gSceneTarget.width == w && gSceneTarget.height == h))
+        return; // minimizada: fica o que havia
 
-    if (glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
-        std::cout << "FBO incompleto!\n";
+    if (gSceneTarget.valid())
+        gTargetPool.release(gSceneTarget);
+    gSceneTarget = gTargetPool.acquire(w, h, GL_RGB8);
+    InvalidateGLState();
 
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, gPresentFBO);
 }
 
 void createFullScreenQuad()
@@ -1383,89 +2407,23 @@ void createFullScreenQuad()
     glBindVertexArray(0);
 }
 
-// Menu 2d
-//
-unsigned int LoadTextureRGBA(const char *path)
-{
-    stbi_set_flip_vertically_on_load(true);
-    int w, h, n;
-    unsigned char *data = stbi_load(path, &w, &h, &n, 4); // força RGBA
-    if (!data)
-    {
-        std::cout << "Falha a carregar textura: " << path << "\n";
-        return 0;
-    }
-
-    GLuint tex;
-    glGenTextures(1, &tex);
-    glBindTexture(GL_TEXTURE_2D, tex);
-
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, w, h, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
-    glBindTexture(GL_TEXTURE_2D, 0);
-
-    stbi_image_free(data);
-    return tex;
-}
-
-void CreateUIQuad()
+glm::mat4 OrthoTopLeft(float w, float h)
 {
-    // 2 triângulos, mas as posições vão ser actualizadas por drawRect (via uniforms ou VBO dinâmico).
-    // Mais simples: mandar um quad já em "pixel space" por VBO dinâmico.
-    glGenVertexArrays(1, &uiVAO);
-    glGenBuffers(1, &uiVBO);
-
-    glBindVertexArray(uiVAO);
-    glBindBuffer(GL_ARRAY_BUFFER, uiVBO);
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, nullptr, GL_DYNAMIC_DRAW); // 6 vertices, (x,y,u,v)
-
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void *)0);
-
-    glEnableVertexAttribArray(1);
-    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, 4 * sizeof(float), (void *)(2 * sizeof(float)));
-
-    glBindVertexArray(0);
+    // left=0 right=w, bottom=h top=0  -> (0,0) em cima
+    return glm::ortho(0.0f, w, h, 0.0f, -1.0f, 1.0f);
 }
 
-void DrawRectUI(Shader &uiShader, const Rect &r, GLuint tex)
+void cursor_pos_callback(GLFWwindow *window, double xpos, double ypos)
 {
-    // Atenção: vamos usar (0,0) no topo-esquerda. A ortho vai tratar disso.
-    float x = r.x, y = r.y, w = r.w, h = r.h;
-
-    float verts[] = {
-        // x,y        u,v
-        x, y + h, 0, 0,
-        x, y, 0, 1,
-        x + w, y, 1, 1,
-
-        x, y + h, 0, 0,
-        x + w, y, 1, 1,
-        x + w, y + h, 1, 0};
-
-    glBindBuffer(GL_ARRAY_BUFFER, uiVBO);
-    glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(verts), verts);
-
-    glActiveTexture(GL_TEXTURE0);
-    glBindTexture(GL_TEXTURE_2D, tex);
-    uiShader.setInt("uTex", 0);
-
-    glBindVertexArray(uiVAO);
-    glDrawArrays(GL_TRIANGLES, 0, 6);
-    glBindVertexArray(0);
+    PushInput(InputEvent::CURSOR, 0, 0, xpos, ypos);
 }
 
-glm::mat4 OrthoTopLeft(float w, float h)
+void mouse_button_callback(GLFWwindow *window, int button, int action, int mods)
 {
-    // left=0 right=w, bottom=h top=0  -> (0,0) em cima
-    return glm::ortho(0.0f, w, h, 0.0f, -1.0f, 1.0f);
+    PushInput(InputEvent::BUTTON, button, action, 0.0, 0.0);
 }
 
-void cursor_pos_callback(GLFWwindow *window, double xpos, double ypos)
+void HandleCursor(double xpos, double ypos)
 {
     gMouseX = (float)xpos;
     gMouseY = (float)ypos;
@@ -1474,6 +2432,7 @@ void cursor_pos_callback(GLFWwindow *window, double xpos, double ypos)
         return;
 
     // --- a partir daqui é a tua lógica FPS (adaptada) ---
+    // o cursor está preso (GLFW_CURSOR_DISABLED), por isso não é preciso recentrar
     if (firstMouse)
     {
         lastX = (float)xpos;
@@ -1482,34 +2441,26 @@ void cursor_pos_callback(GLFWwindow *window, double xpos, double ypos)
     }
 
     float xoffset = ((float)xpos - lastX) * mouse_sense;
-    float yoffset = (lastY - (float)ypos) * mouse_sense;
+    float yoffset = (lastY - (float)ypos) * mouse_sense; // reversed since y-coordinates go from bottom to top
 
     lastX = (float)xpos;
     lastY = (float)ypos;
 
     camera.ProcessMouseMovement(xoffset, yoffset);
-
-    // recentrar (FPS)
-    glfwSetCursorPos(window, centerX, centerY);
-    lastX = centerX;
-    lastY = centerY;
 }
 
-void mouse_button_callback(GLFWwindow *window, int button, int action, int mods)
+void HandleMenuClick(GLFWwindow *window)
 {
-    if (button != GLFW_MOUSE_BUTTON_LEFT || action != GLFW_PRESS)
-        return;
-
     if (state == GameState::MENU_MAIN)
     {
         if (btnStart.contains(gMouseX, gMouseY))
         {
-            state = GameState::MENU_MODE;
-            BuildMenuLayout();
+            SetState(GameState::MENU_MODE);
         }
         else if (btnExitMain.contains(gMouseX, gMouseY))
         {
             glfwSetWindowShouldClose(window, true);
+            glfwPostEmptyEvent();
         }
     }
     else if (state == GameState::MENU_MODE)
@@ -1528,8 +2479,7 @@ void mouse_button_callback(GLFWwindow *window, int button, int action, int mods)
         }
         else if (btnExitMode.contains(gMouseX, gMouseY))
         {
-            state = GameState::MENU_MAIN;
-            BuildMenuLayout();
+            SetState(GameState::MENU_MAIN);
         }
     }
     else if (state == GameState::VICTORY)
@@ -1537,6 +2487,7 @@ void mouse_button_callback(GLFWwindow *window, int button, int action, int mods)
         if (btnExitVictory.contains(gMouseX, gMouseY))
         {
             glfwSetWindowShouldClose(window, true);
+            glfwPostEmptyEvent();
         }
     }
 }
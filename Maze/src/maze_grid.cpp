@@ -0,0 +1,186 @@
+#include <./include/maze_grid.h>
+#include <./include/profiler.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <utility>
+
+// Tamanho do labirinto
+//
+int MAZE_W;
+int MAZE_H;
+
+MazeGrid maze;
+
+void MazeGrid::allocate(LevelArena &arena, int width, int height)
+{
+    cells = arena.allocArray<int>((size_t)width * height);
+    w = width;
+    h = height;
+}
+
+size_t LevelArenaBytes(int width, int height)
+{
+    size_t cells = (size_t)width * height;
+    // grelha (int) + blocos (vec3, no máximo um por célula) + pilha da geração + BFS (2 ints)
+    size_t bytes = cells * (sizeof(int) + 3 * sizeof(float) + 2 * sizeof(int)) + (cells / 4 + 1) * 3 * sizeof(int);
+    return bytes + bytes / 8 + 4096;
+}
+
+// Gerar labirinto
+//
+
+// Backtracking em profundidade. Era recursivo, mas num labirinto 2001x2001 a recursão chega
+// a centenas de milhares de níveis e rebenta a stack; a pilha explícita guarda (x, z, i) de cada
+// nível. As direcções continuam num array partilhado e baralhado à entrada de cada célula,
+// como na versão recursiva, para a mesma seed dar exactamente o mesmo labirinto.
+void carveMaze(LevelArena &arena, int x, int z)
+{
+    static int dirs[4][2] = {
+        {1, 0},  // direita
+        {-1, 0}, // esquerda
+        {0, 1},  // baixo
+        {0, -1}  // cima
+    };
+
+    struct Step
+    {
+        int x, z, i;
+    };
+    // cada nível da pilha abre uma célula de coordenadas ímpares: nunca passa desse número
+    size_t maxDepth = (size_t)(MAZE_W / 2) * (MAZE_H / 2) + 1;
+    Step *stack = arena.allocArray<Step>(maxDepth);
+    size_t depth = 0;
+
+    Step first = {x, z, 0};
+    stack[depth++] = first;
+    bool entered = true;
+
+    while (depth > 0)
+    {
+        if (entered)
+        {
+            // baralhar direções
+            for (int i = 0; i < 4; i++)
+            {
+                int r = rand() % 4;
+                std::swap(dirs[i], dirs[r]);
+            }
+            entered = false;
+        }
+
+        Step &s = stack[depth - 1];
+        if (s.i == 4)
+        {
+            depth--;
+            continue;
+        }
+        int i = s.i++;
+
+        int nx = s.x + dirs[i][0] * 2;
+        int nz = s.z + dirs[i][1] * 2;
+
+        if (nx > 0 && nz > 0 && nx < MAZE_W - 1 && nz < MAZE_H - 1)
+        {
+            if (maze[nz][nx] == 1)
+            {
+                maze[s.z + dirs[i][1]][s.x + dirs[i][0]] = 0;
+                maze[nz][nx] = 0;
+
+                Step next = {nx, nz, 0};
+                stack[depth++] = next;
+                entered = true;
+            }
+        }
+    }
+}
+
+void generateMaze(LevelArena &arena)
+{
+    PROFILE_SCOPE("generateMaze");
+
+    maze.allocate(arena, MAZE_W, MAZE_H);
+
+    for (int z = 0; z < MAZE_H; z++)
+        for (int x = 0; x < MAZE_W; x++)
+            maze[z][x] = 1;
+
+    maze[1][1] = 0;
+    carveMaze(arena, 1, 1);
+
+    for (int x = 0; x < MAZE_W; x++)
+    {
+        maze[0][x] = 1;
+        maze[MAZE_H - 1][x] = 1;
+    }
+
+    for (int z = 0; z < MAZE_H; z++)
+    {
+        maze[z][0] = 1;
+        maze[z][MAZE_W - 1] = 1;
+    }
+
+    maze[1][0] = 0;
+    maze[1][1] = 0;
+
+    int exitZ = MAZE_H - 2;
+
+    maze[exitZ][MAZE_W - 2] = 0;
+    maze[exitZ][MAZE_W - 1] = 0;
+}
+
+// Função de colisão
+//
+static inline float clampf(float v, float a, float b) { return (v < a) ? a : (v > b) ? b
+                                                                                     : v; }
+
+bool checkCollision(glm::vec3 pos)
+{
+    PROFILE_SCOPE("checkCollision");
+
+    const float r = PLAYER_RADIUS;
+    const float r2 = r * r;
+
+    // limites do mundo
+    const float minWorldX = 0.0f;
+    const float minWorldZ = 0.0f;
+    const float maxWorldX = MAZE_W * CELL_SIZE;
+    const float maxWorldZ = MAZE_H * CELL_SIZE;
+
+    if (pos.x - r < minWorldX || pos.x + r > maxWorldX ||
+        pos.z - r < minWorldZ || pos.z + r > maxWorldZ)
+        return true;
+
+    int cx = (int)floor(pos.x / CELL_SIZE);
+    int cz = (int)floor(pos.z / CELL_SIZE);
+
+    for (int dz = -1; dz <= 1; dz++)
+    {
+        for (int dx = -1; dx <= 1; dx++)
+        {
+            int mx = cx + dx;
+            int mz = cz + dz;
+
+            if (mx < 0 || mx >= MAZE_W || mz < 0 || mz >= MAZE_H)
+                continue;
+
+            if (maze[mz][mx] != 1)
+                continue;
+
+            float minX = mx * CELL_SIZE;
+            float maxX = minX + CELL_SIZE;
+            float minZ = mz * CELL_SIZE;
+            float maxZ = minZ + CELL_SIZE;
+
+            float closestX = clampf(pos.x, minX, maxX);
+            float closestZ = clampf(pos.z, minZ, maxZ);
+
+            float dxp = pos.x - closestX;
+            float dzp = pos.z - closestZ;
+
+            if ((dxp * dxp + dzp * dzp) < r2)
+                return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,142 @@
+#include <./include/mem_tracker.h>
+
+#include <atomic>
+#include <cstdlib>
+
+static const char *const MEM_TAG_NAMES[MEM_TAG_COUNT] = {"maze", "mesh", "texture", "audio", "ui", "gl"};
+
+struct MemCounters
+{
+    std::atomic<size_t> current;
+    std::atomic<size_t> peak;
+    std::atomic<uint64_t> allocs;
+    std::atomic<uint64_t> frees;
+};
+
+// zeradas antes de qualquer construtor (memória estática), por isso servem também aos globais
+static MemCounters gMem[MEM_TAG_COUNT];
+static MemCounters gHeap; // soma das tags excepto MEM_GL (só current/peak)
+
+// cabeçalho do MemTaggedMalloc: 16 bytes para manter o alinhamento do malloc
+struct MemHeader
+{
+    size_t bytes;
+    size_t tag;
+};
+static const size_t MEM_HEADER_SIZE = 16;
+static_assert(sizeof(MemHeader) <= MEM_HEADER_SIZE, "cabeçalho maior que o espaço reservado");
+
+static void RaisePeak(std::atomic<size_t> &peak, size_t value)
+{
+    size_t old = peak.load(std::memory_order_relaxed);
+    while (value > old && !peak.compare_exchange_weak(old, value, std::memory_order_relaxed))
+    {
+    }
+}
+
+const char *MemTagName(MemTag tag)
+{
+    return (unsigned)tag < MEM_TAG_COUNT ? MEM_TAG_NAMES[tag] : "?";
+}
+
+void MemTrackAlloc(MemTag tag, size_t bytes)
+{
+    if (!bytes)
+        return;
+    MemCounters &c = gMem[tag];
+    RaisePeak(c.peak, c.current.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+    c.allocs.fetch_add(1, std::memory_order_relaxed);
+    if (tag != MEM_GL)
+        RaisePeak(gHeap.peak, gHeap.current.fetch_add(bytes, std::memory_order_relaxed) + bytes);
+}
+
+void MemTrackFree(MemTag tag, size_t bytes)
+{
+    if (!bytes)
+        return;
+    gMem[tag].current.fetch_sub(bytes, std::memory_order_relaxed);
+    gMem[tag].frees.fetch_add(1, std::memory_order_relaxed);
+    if (tag != MEM_GL)
+        gHeap.current.fetch_sub(bytes, std::memory_order_relaxed);
+}
+
+MemTagStats MemStats(MemTag tag)
+{
+    const MemCounters &c = gMem[tag];
+    MemTagStats s;
+    s.current = c.current.load(std::memory_order_relaxed);
+    s.peak = c.peak.load(std::memory_order_relaxed);
+    s.allocs = c.allocs.load(std::memory_order_relaxed);
+    s.frees = c.frees.load(std::memory_order_relaxed);
+    return s;
+}
+
+size_t MemHeapCurrent()
+{
+    return gHeap.current.load(std::memory_order_relaxed);
+}
+
+size_t MemHeapPeak()
+{
+    return gHeap.peak.load(std::memory_order_relaxed);
+}
+
+void *MemTaggedMalloc(MemTag tag, size_t bytes)
+{
+    char *base = (char *)malloc(bytes + MEM_HEADER_SIZE);
+    if (!base)
+        return nullptr;
+    MemHeader *h = (MemHeader *)base;
+    h->bytes = bytes;
+    h->tag = (size_t)tag;
+    MemTrackAlloc(tag, bytes);
+    return base + MEM_HEADER_SIZE;
+}
+
+void *MemTaggedRealloc(MemTag tag, void *p, size_t bytes)
+{
+    if (!p)
+        return MemTaggedMalloc(tag, bytes);
+
+    char *base = (char *)p - MEM_HEADER_SIZE;
+    MemHeader old = *(MemHeader *)base;
+    char *grown = (char *)realloc(base, bytes + MEM_HEADER_SIZE);
+    if (!grown)
+        return nullptr; // o bloco antigo continua válido (e contado)
+
+    MemTrackFree((MemTag)old.tag, old.bytes);
+    MemHeader *h = (MemHeader *)grown;
+    h->bytes = bytes;
+    h->tag = (size_t)tag;
+    MemTrackAlloc(tag, bytes);
+    return grown + MEM_HEADER_SIZE;
+}
+
+void MemTaggedFree(void *p)
+{
+    if (!p)
+        return;
+    char *base = (char *)p - MEM_HEADER_SIZE;
+    const MemHeader *h = (const MemHeader *)base;
+    MemTrackFree((MemTag)h->tag, h->bytes);
+    free(base);
+}
+
+int MemLeakReport(FILE *out)
+{
+    int leaks = 0;
+    fprintf(out, "[mem] pico do heap contado: %.2f MB\n", MemHeapPeak() / (1024.0 * 1024.0));
+    for (int t = 0; t < MEM_TAG_COUNT; t++)
+    {
+        MemTagStats s = MemStats((MemTag)t);
+        fprintf(out, "[mem] %-8s pico %10.1f KB  %8llu alocações\n", MEM_TAG_NAMES[t], s.peak / 1024.0,
+                (unsigned long long)s.allocs);
+        if (s.current || s.allocs != s.frees)
+        {
+            fprintf(out, "[mem] FUGA %-8s %zu bytes em %lld blocos por libertar\n", MEM_TAG_NAMES[t], s.current,
+                    (long long)(s.allocs - s.frees));
+            leaks++;
+        }
+    }
+    return leaks;
+}
@@ -1,4 +1,5 @@
 #include "./include/objloader.hpp"
+#include "./include/assetfs.h"
 
 // Very, VERY simple OBJ loader.
 // Here is a short list of features a real function would provide : 
@@ -14,19 +15,23 @@
 //Recebe um ficheiro .obj e 3 arrays, um para guardar as coordenadas dos vertices, outro para as uvs e outro para as normais
 bool loadOBJ(
 	const char * path, 
-	std::vector<glm::vec3> & out_vertices, 
-	std::vector<glm::vec2> & out_uvs,
-	std::vector<glm::vec3> & out_normals
+	MeshVector<glm::vec3> & out_vertices, 
+	MeshVector<glm::vec2> & out_uvs,
+	MeshVector<glm::vec3> & out_normals
 ){
 	printf("Loading OBJ file %s...\n", path);
 
-	std::vector<unsigned int> vertexIndices, uvIndices, normalIndices;
-	std::vector<glm::vec3> temp_vertices; 
-	std::vector<glm::vec2> temp_uvs;
-	std::vector<glm::vec3> temp_normals;
+	MeshVector<unsigned int> vertexIndices, uvIndices, normalIndices;
+	MeshVector<glm::vec3> temp_vertices; 
+	MeshVector<glm::vec2> temp_uvs;
+	MeshVector<glm::vec3> temp_normals;
 
 
-	FILE * file = fopen(path, "r");
+	// lido através dos assets (disco ou embutido no executável)
+	AssetBlob blob;
+	FILE * file = NULL;
+	if( ReadAsset(path, blob) && blob.size > 0 )
+		file = fmemopen((void *)blob.data, blob.size, "r");
 	if( file == NULL ){
 		printf("Impossible to open the file ! Are you in the right path ? See Tutorial 1 for details\n");
 		getchar();
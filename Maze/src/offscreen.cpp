@@ -0,0 +1,48 @@
+#include <./include/offscreen.h>
+#include <./include/mem_tracker.h>
+
+OffscreenTarget::OffscreenTarget() : framebuffer(0), color(0), depth(0), w(0), h(0)
+{
+}
+
+bool OffscreenTarget::resize(int width, int height)
+{
+    if (framebuffer && width == w && height == h)
+        return true;
+
+    if (!framebuffer)
+    {
+        glGenFramebuffers(1, &framebuffer);
+        glGenRenderbuffers(1, &color);
+        glGenRenderbuffers(1, &depth);
+    }
+    MemTrackFree(MEM_GL, (size_t)w * h * 8); // RGBA8 + DEPTH24_STENCIL8
+    w = width;
+    h = height;
+    MemTrackAlloc(MEM_GL, (size_t)w * h * 8);
+
+    glBindRenderbuffer(GL_RENDERBUFFER, color);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, w, h);
+    glBindRenderbuffer(GL_RENDERBUFFER, depth);
+    glRenderbufferStorage(GL_RENDERBUFFER, GL_DEPTH24_STENCIL8, w, h);
+    glBindRenderbuffer(GL_RENDERBUFFER, 0);
+
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color);
+    glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_DEPTH_STENCIL_ATTACHMENT, GL_RENDERBUFFER, depth);
+    bool complete = glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+    glBindFramebuffer(GL_FRAMEBUFFER, 0);
+    return complete;
+}
+
+void OffscreenTarget::shutdown()
+{
+    if (!framebuffer)
+        return;
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteRenderbuffers(1, &color);
+    glDeleteRenderbuffers(1, &depth);
+    framebuffer = color = depth = 0;
+    MemTrackFree(MEM_GL, (size_t)w * h * 8);
+    w = h = 0;
+}
@@ -0,0 +1,174 @@
+#include <./include/profiler.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+namespace
+{
+    // zonas guardadas por thread (as mais antigas são reescritas)
+    const unsigned RING_SIZE = 1u << 16;
+
+    struct Zone
+    {
+        const char *name;
+        uint64_t start;
+        uint64_t end;
+    };
+
+    struct ThreadRing
+    {
+        int tid;
+        std::string name;
+        Zone zones[RING_SIZE];
+        std::atomic<unsigned> count; // total escrito (índice = count % RING_SIZE)
+
+        ThreadRing() : tid(0), count(0) {}
+    };
+
+    std::mutex gRingsMtx;
+    std::vector<ThreadRing *> gRings; // nunca são libertados (as threads podem acabar antes do dump)
+    std::atomic<bool> gEnabled(true);
+    const std::chrono::steady_clock::time_point gEpoch = std::chrono::steady_clock::now();
+
+    thread_local ThreadRing *tRing = nullptr;
+    ThreadRing *gGpuRing = nullptr;
+
+    ThreadRing *NewRing(const char *name)
+    {
+        ThreadRing *ring = new ThreadRing();
+        std::lock_guard<std::mutex> lock(gRingsMtx);
+        ring->tid = (int)gRings.size() + 1;
+        if (name)
+            ring->name = name;
+        gRings.push_back(ring);
+        return ring;
+    }
+
+    ThreadRing *CurrentRing()
+    {
+        if (!tRing)
+            tRing = NewRing(nullptr);
+        return tRing;
+    }
+
+    void Push(ThreadRing *ring, const char *name, uint64_t startNs, uint64_t endNs)
+    {
+        unsigned i = ring->count.load(std::memory_order_relaxed);
+        Zone &z = ring->zones[i % RING_SIZE];
+        z.name = name;
+        z.start = startNs;
+        z.end = endNs;
+        ring->count.store(i + 1, std::memory_order_release);
+    }
+
+    // nomes das zonas são literais, mas por segurança escapar aspas e barras
+    void WriteJsonString(FILE *f, const char *s)
+    {
+        fputc('"', f);
+        for (; *s; s++)
+        {
+            if (*s == '"' || *s == '\\')
+                fputc('\\', f);
+            fputc(*s, f);
+        }
+        fputc('"', f);
+    }
+}
+
+namespace Profiler
+{
+    void setThreadName(const char *name)
+    {
+        ThreadRing *ring = CurrentRing();
+        std::lock_guard<std::mutex> lock(gRingsMtx);
+        ring->name = name;
+    }
+
+    void setEnabled(bool on)
+    {
+        gEnabled = on;
+    }
+
+    bool enabled()
+    {
+        return gEnabled.load(std::memory_order_relaxed);
+    }
+
+    uint64_t nowNs()
+    {
+        // +1 para nunca dar 0 (0 = zona desligada no ProfileScope)
+        return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - gEpoch).count() + 1;
+    }
+
+    void record(const char *name, uint64_t startNs, uint64_t endNs)
+    {
+        Push(CurrentRing(), name, startNs, endNs);
+    }
+
+    void recordGpu(const char *name, uint64_t startNs, uint64_t endNs)
+    {
+        if (!enabled())
+            return;
+        if (!gGpuRing)
+            gGpuRing = NewRing("GPU");
+        Push(gGpuRing, name, startNs, endNs);
+    }
+
+    bool dump(const std::string &path)
+    {
+        FILE *f = fopen(path.c_str(), "w");
+        if (!f)
+            return false;
+
+        std::vector<ThreadRing *> rings;
+        {
+            std::lock_guard<std::mutex> lock(gRingsMtx);
+            rings = gRings;
+        }
+
+        fprintf(f, "{\"traceEvents\":[\n");
+        bool first = true;
+        size_t zoneCount = 0;
+        for (size_t r = 0; r < rings.size(); r++)
+        {
+            ThreadRing *ring = rings[r];
+
+            std::string threadName;
+            {
+                std::lock_guard<std::mutex> lock(gRingsMtx);
+                threadName = ring->name;
+            }
+            if (!threadName.empty())
+            {
+                fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":", first ? "" : ",\n", ring->tid);
+                WriteJsonString(f, threadName.c_str());
+                fprintf(f, "}}");
+                first = false;
+            }
+
+            // a thread pode continuar a escrever: lê só o que já estava publicado
+            // (com o buffer a dar a volta durante o dump podem sair zonas mais recentes misturadas)
+            unsigned end = ring->count.load(std::memory_order_acquire);
+            unsigned begin = end > RING_SIZE ? end - RING_SIZE : 0;
+            for (unsigned i = begin; i != end; i++)
+            {
+                Zone z = ring->zones[i % RING_SIZE];
+                fprintf(f, "%s{\"name\":", first ? "" : ",\n");
+                WriteJsonString(f, z.name);
+                fprintf(f, ",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                        ring->tid, z.start / 1000.0, (z.end - z.start) / 1000.0);
+                first = false;
+                zoneCount++;
+            }
+        }
+        fprintf(f, "\n]}\n");
+
+        bool ok = ferror(f) == 0;
+        fclose(f);
+        printf("[profiler] %zu zonas em %s\n", zoneCount, path.c_str());
+        return ok;
+    }
+}
@@ -0,0 +1,241 @@
+#include <./include/replay.h>
+
+#include <algorithm>
+#include <cstring>
+#include <stdint.h>
+
+static const char REPLAY_MAGIC[4] = {'M', 'Z', 'R', 'P'};
+static const uint32_t REPLAY_VERSION = 1;
+
+enum ReplayRecord
+{
+    RECORD_EVENT = 1,
+    RECORD_CAMERA = 2,
+    RECORD_END = 3
+};
+
+// campos um a um (sem depender do padding das structs)
+template <typename T>
+static void Put(FILE *f, T value)
+{
+    fwrite(&value, sizeof(T), 1, f);
+}
+
+template <typename T>
+static bool Get(FILE *f, T &value)
+{
+    return fread(&value, sizeof(T), 1, f) == 1;
+}
+
+// ===================== InputRecorder =====================
+
+bool InputRecorder::open(const char *path, const ReplayHeader &h)
+{
+    close(0);
+    file = fopen(path, "wb");
+    if (!file)
+        return false;
+
+    fwrite(REPLAY_MAGIC, 1, 4, file);
+    Put<uint32_t>(file, REPLAY_VERSION);
+    Put<uint32_t>(file, h.seed);
+    Put<int32_t>(file, h.mode);
+    Put<float>(file, h.yaw);
+    Put<float>(file, h.pitch);
+    Put<float>(file, h.zoom);
+    Put<float>(file, h.mouseSense);
+    Put<float>(file, h.arrowSense);
+    Put<uint8_t>(file, h.fixY);
+    Put<uint8_t>(file, h.flashlightOn);
+    return true;
+}
+
+void InputRecorder::event(unsigned tick, double time, const InputEvent &ev)
+{
+    if (!file)
+        return;
+    Put<uint8_t>(file, RECORD_EVENT);
+    Put<uint32_t>(file, tick);
+    Put<float>(file, (float)time);
+    Put<uint8_t>(file, (uint8_t)ev.type);
+    Put<int16_t>(file, (int16_t)ev.code);
+    Put<int8_t>(file, (int8_t)ev.action);
+    Put<double>(file, ev.x);
+    Put<double>(file, ev.y);
+}
+
+void InputRecorder::camera(unsigned tick, const glm::vec3 &pos, float yaw, float pitch)
+{
+    if (!file)
+        return;
+    Put<uint8_t>(file, RECORD_CAMERA);
+    Put<uint32_t>(file, tick);
+    Put<float>(file, pos.x);
+    Put<float>(file, pos.y);
+    Put<float>(file, pos.z);
+    Put<float>(file, yaw);
+    Put<float>(file, pitch);
+}
+
+void InputRecorder::close(unsigned endTick)
+{
+    if (!file)
+        return;
+    Put<uint8_t>(file, RECORD_END);
+    Put<uint32_t>(file, endTick);
+    fclose(file);
+    file = nullptr;
+}
+
+// ===================== InputReplay =====================
+
+bool InputReplay::load(const char *path)
+{
+    FILE *f = fopen(path, "rb");
+    if (!f)
+        return false;
+
+    char magic[4];
+    uint32_t version = 0, seed = 0;
+    int32_t mode = 0;
+    uint8_t fixY = 0, flashlightOn = 0;
+    bool ok = fread(magic, 1, 4, f) == 4 && memcmp(magic, REPLAY_MAGIC, 4) == 0 &&
+              Get(f, version) && version == REPLAY_VERSION &&
+              Get(f, seed) && Get(f, mode) && Get(f, head.yaw) && Get(f, head.pitch) && Get(f, head.zoom) &&
+              Get(f, head.mouseSense) && Get(f, head.arrowSense) && Get(f, fixY) && Get(f, flashlightOn);
+    head.seed = seed;
+    head.mode = mode;
+    head.fixY = fixY != 0;
+    head.flashlightOn = flashlightOn != 0;
+
+    events.clear();
+    cameras.clear();
+    nextIndex = 0;
+    lastTick = 0;
+
+    bool ended = false;
+    uint8_t kind;
+    while (ok && !ended && Get(f, kind))
+    {
+        uint32_t tick = 0;
+        ok = Get(f, tick);
+        if (kind == RECORD_EVENT)
+        {
+            TimedEvent te;
+            float time;
+            uint8_t type;
+            int16_t code;
+            int8_t action;
+            ok = ok && Get(f, time) && Get(f, type) && Get(f, code) && Get(f, action) && Get(f, te.ev.x) && Get(f, te.ev.y);
+            te.tick = tick;
+            te.ev.type = (InputEvent::Type)type;
+            te.ev.code = code;
+            te.ev.action = action;
+            te.ev.time = time;
+            events.push_back(te);
+        }
+        else if (kind == RECORD_CAMERA)
+        {
+            ReplayCameraSample s;
+            s.tick = tick;
+            ok = ok && Get(f, s.pos.x) && Get(f, s.pos.y) && Get(f, s.pos.z) && Get(f, s.yaw) && Get(f, s.pitch);
+            cameras.push_back(s);
+        }
+        else if (kind == RECORD_END)
+            ended = true;
+        else
+            ok = false;
+        lastTick = tick;
+    }
+    fclose(f);
+
+    // gravação cortada (o jogo foi morto): fica o que se leu até ao último registo inteiro
+    return ok || !events.empty();
+}
+
+bool InputReplay::nextEvent(unsigned tick, InputEvent &ev)
+{
+    if (nextIndex >= events.size() || events[nextIndex].tick > tick)
+        return false;
+    ev = events[nextIndex++].ev;
+    return true;
+}
+
+bool InputReplay::cameraAt(unsigned tick, ReplayCameraSample &out) const
+{
+    // amostras por ordem de tick
+    size_t lo = 0, hi = cameras.size();
+    while (lo < hi)
+    {
+        size_t mid = (lo + hi) / 2;
+        if (cameras[mid].tick < tick)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    if (lo == cameras.size() || cameras[lo].tick != tick)
+        return false;
+    out = cameras[lo];
+    return true;
+}
+
+// ===================== Relatório =====================
+
+FrameTimeSummary SummarizeFrameTimes(const std::vector<float> &frameMs)
+{
+    FrameTimeSummary s;
+    std::vector<float> sorted(frameMs);
+    std::sort(sorted.begin(), sorted.end());
+    size_t n = sorted.size();
+    if (!n)
+        return s;
+
+    double sum = 0.0;
+    for (size_t i = 0; i < n; i++)
+        sum += sorted[i];
+
+    s.frames = n;
+    s.mean = (float)(sum / n);
+    s.p50 = sorted[n * 50 / 100];
+    s.p95 = sorted[n * 95 / 100];
+    s.p99 = sorted[n * 99 / 100];
+    s.max = sorted[n - 1];
+    return s;
+}
+
+void WriteFrameTimeJson(FILE *f, const FrameTimeSummary &s)
+{
+    fprintf(f, "{\"mean\": %.4f, \"p50\": %.4f, \"p95\": %.4f, \"p99\": %.4f, \"max\": %.4f}",
+            s.mean, s.p50, s.p95, s.p99, s.max);
+}
+
+bool WriteReplayReport(const char *path, const ReplayResult &r)
+{
+    FrameTimeSummary s = SummarizeFrameTimes(r.frameMs);
+
+    printf("[replay] %u ticks, %zu frames em %.2f s: média %.2f  p50 %.2f  p95 %.2f  p99 %.2f  max %.2f ms\n",
+           r.ticks, s.frames, r.wallSeconds, s.mean, s.p50, s.p95, s.p99, s.max);
+    if (r.maxCameraDrift > 0.001f)
+        printf("[replay] aviso: a câmara afastou-se %.4f da gravação (replay não determinístico)\n", r.maxCameraDrift);
+
+    FILE *f = fopen(path, "w");
+    if (!f)
+        return false;
+
+    fprintf(f, "{\n");
+    fprintf(f, "  \"replay\": \"%s\",\n", r.file.c_str());
+    fprintf(f, "  \"seed\": %u,\n", r.header.seed);
+    fprintf(f, "  \"mode\": %d,\n", r.header.mode);
+    fprintf(f, "  \"unthrottled\": %s,\n", r.unthrottled ? "true" : "false");
+    fprintf(f, "  \"completed\": %s,\n", r.completed ? "true" : "false");
+    fprintf(f, "  \"ticks\": %u,\n", r.ticks);
+    fprintf(f, "  \"frames\": %zu,\n", s.frames);
+    fprintf(f, "  \"wall_s\": %.4f,\n", r.wallSeconds);
+    fprintf(f, "  \"camera_drift_max\": %.6f,\n", r.maxCameraDrift);
+    fprintf(f, "  \"frame_ms\": ");
+    WriteFrameTimeJson(f, s);
+    fprintf(f, "\n");
+    fprintf(f, "}\n");
+    fclose(f);
+    return true;
+}
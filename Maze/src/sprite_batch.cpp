@@ -0,0 +1,139 @@
+#include <./include/sprite_batch.h>
+#include <./include/gl_state.h>
+#include <./include/profiler.h>
+
+#include <algorithm>
+
+SpriteBatch::SpriteBatch() : vao(0), vbo(0), vboBytes(0)
+{
+}
+
+bool SpriteBatch::init()
+{
+    glGenVertexArrays(1, &vao);
+    glGenBuffers(1, &vbo);
+    glBindVertexArray(vao);
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void *)0);
+    glEnableVertexAttribArray(1);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void *)(2 * sizeof(float)));
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(2, 4, GL_UNSIGNED_BYTE, GL_TRUE, sizeof(SpriteVertex), (void *)(4 * sizeof(float)));
+    glEnableVertexAttribArray(3);
+    glVertexAttribPointer(3, 1, GL_FLOAT, GL_FALSE, sizeof(SpriteVertex), (void *)(5 * sizeof(float)));
+
+    glBindVertexArray(0);
+    InvalidateGLState();
+
+    sprites.reserve(2048);
+    verts.reserve(6 * 2048);
+    return vao != 0 && vbo != 0;
+}
+
+void SpriteBatch::shutdown()
+{
+    if (vao)
+        glDeleteVertexArrays(1, &vao);
+    if (vbo)
+        glDeleteBuffers(1, &vbo);
+    vao = vbo = 0;
+    MemTrackFree(MEM_GL, vboBytes);
+    vboBytes = 0;
+}
+
+void SpriteBatch::add(float x, float y, float w, float h, GLuint tex, float u0, float v0, float u1, float v1,
+                      unsigned int rgba, int layer)
+{
+    Sprite s = {x, y, w, h, u0, v0, u1, v1, rgba, tex, layer};
+    sprites.push_back(s);
+}
+
+void SpriteBatch::addImage(float x, float y, float w, float h, GLuint tex, int layer)
+{
+    add(x, y, w, h, tex, 0.0f, 1.0f, 1.0f, 0.0f, SPRITE_WHITE, layer);
+}
+
+int SpriteBatch::flush(Shader &shader, const glm::mat4 &proj)
+{
+    if (sprites.empty())
+        return 0;
+
+    PROFILE_SCOPE("sprite batch");
+
+    // camada primeiro (ordem de desenho), depois textura (junta os sprites que a partilham)
+    std::stable_sort(sprites.begin(), sprites.end(), [](const Sprite &a, const Sprite &b)
+                     { return a.layer != b.layer ? a.layer < b.layer : a.tex < b.tex; });
+
+    // vértices + grupos de até SPRITE_BATCH_TEXTURES texturas (um draw por grupo)
+    verts.clear();
+    ranges.clear();
+    DrawRange range;
+    range.first = 0;
+    range.textureCount = 0;
+
+    for (size_t i = 0; i < sprites.size(); i++)
+    {
+        const Sprite &s = sprites[i];
+
+        int slot = 0;
+        while (slot < range.textureCount && range.textures[slot] != s.tex)
+            slot++;
+        if (slot == SPRITE_BATCH_TEXTURES)
+        {
+            range.count = (GLsizei)verts.size() - range.first;
+            ranges.push_back(range);
+            range.first = (GLint)verts.size();
+            range.textureCount = 0;
+            slot = 0;
+        }
+        if (slot == range.textureCount)
+            range.textures[range.textureCount++] = s.tex;
+
+        float fs = (float)slot;
+        SpriteVertex a = {s.x, s.y, s.u0, s.v0, s.rgba, fs};
+        SpriteVertex b = {s.x + s.w, s.y, s.u1, s.v0, s.rgba, fs};
+        SpriteVertex c = {s.x + s.w, s.y + s.h, s.u1, s.v1, s.rgba, fs};
+        SpriteVertex d = {s.x, s.y + s.h, s.u0, s.v1, s.rgba, fs};
+
+        verts.push_back(a);
+        verts.push_back(b);
+        verts.push_back(c);
+        verts.push_back(a);
+        verts.push_back(c);
+        verts.push_back(d);
+    }
+    range.count = (GLsizei)verts.size() - range.first;
+    ranges.push_back(range);
+    sprites.clear();
+
+    size_t bytes = verts.size() * sizeof(SpriteVertex);
+    if (bytes > vboBytes)
+    {
+        MemTrackFree(MEM_GL, vboBytes);
+        vboBytes = bytes * 2;
+        MemTrackAlloc(MEM_GL, vboBytes);
+    }
+
+    // orphan: o driver dá memória nova em vez de esperar pelo draw do frame anterior
+    glBindBuffer(GL_ARRAY_BUFFER, vbo);
+    glBufferData(GL_ARRAY_BUFFER, vboBytes, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, verts.data());
+
+    static const GLint units[SPRITE_BATCH_TEXTURES] = {0, 1, 2, 3, 4, 5, 6, 7};
+
+    glDisable(GL_DEPTH_TEST);
+    shader.use();
+    shader.setMat4("uProj", proj);
+    shader.setIntArray("uTex", units, SPRITE_BATCH_TEXTURES);
+    GLBindVertexArray(vao);
+
+    for (size_t r = 0; r < ranges.size(); r++)
+    {
+        for (int t = 0; t < ranges[r].textureCount; t++)
+            GLBindTexture2D(t, ranges[r].textures[t]);
+        GLDrawTriangles(ranges[r].first, ranges[r].count);
+    }
+    return (int)ranges.size();
+}
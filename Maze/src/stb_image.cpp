@@ -1,2 +1,8 @@
+#include "../include/mem_tracker.h"
+
+// os pixels descodificados contam como memória de texturas
+#define STBI_MALLOC(sz) MemTaggedMalloc(MEM_TEXTURE, sz)
+#define STBI_REALLOC(p, newsz) MemTaggedRealloc(MEM_TEXTURE, p, newsz)
+#define STBI_FREE(p) MemTaggedFree(p)
 #define STB_IMAGE_IMPLEMENTATION
 #include "../include/stb_image.h"
\ No newline at end of file
@@ -0,0 +1,411 @@
+#include <./include/telemetry.h>
+#include <./include/mem_tracker.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+// ===================== HdrHistogram =====================
+
+static const int HDR_SUB_BUCKETS = 128; // valores exactos abaixo disto
+static const int HDR_HALF = HDR_SUB_BUCKETS / 2;
+static const int HDR_MAX_SHIFT = 30;                      // 64 << 30 us ~ 19 horas
+static const uint64_t HDR_MAX_US = (1ull << 36) - 1;      // o resto fica no último bucket
+static const int HDR_BUCKETS = HDR_SUB_BUCKETS + HDR_MAX_SHIFT * HDR_HALF;
+
+HdrHistogram::HdrHistogram() : counts(HDR_BUCKETS, 0), total(0), sumUs(0), maxUs(0)
+{
+}
+
+int HdrHistogram::bucketOf(uint64_t us)
+{
+    if (us > HDR_MAX_US)
+        us = HDR_MAX_US;
+    if (us < (uint64_t)HDR_SUB_BUCKETS)
+        return (int)us;
+
+    int msb = 63 - __builtin_clzll(us);
+    int shift = msb - 6; // us >> shift fica em [64, 128)
+    return HDR_SUB_BUCKETS + (shift - 1) * HDR_HALF + (int)(us >> shift) - HDR_HALF;
+}
+
+uint64_t HdrHistogram::bucketTop(int bucket)
+{
+    if (bucket < HDR_SUB_BUCKETS)
+        return (uint64_t)bucket;
+    int shift = (bucket - HDR_SUB_BUCKETS) / HDR_HALF + 1;
+    uint64_t sub = (uint64_t)((bucket - HDR_SUB_BUCKETS) % HDR_HALF + HDR_HALF);
+    return ((sub + 1) << shift) - 1;
+}
+
+void HdrHistogram::record(uint64_t us)
+{
+    counts[bucketOf(us)]++;
+    total++;
+    sumUs += us;
+    if (us > maxUs)
+        maxUs = us;
+}
+
+void HdrHistogram::reset()
+{
+    std::fill(counts.begin(), counts.end(), 0);
+    total = sumUs = maxUs = 0;
+}
+
+void HdrHistogram::add(const HdrHistogram &other)
+{
+    for (int i = 0; i < HDR_BUCKETS; i++)
+        counts[i] += other.counts[i];
+    total += other.total;
+    sumUs += other.sumUs;
+    if (other.maxUs > maxUs)
+        maxUs = other.maxUs;
+}
+
+uint64_t HdrHistogram::percentile(double p) const
+{
+    if (!total)
+        return 0;
+    uint64_t target = (uint64_t)(p / 100.0 * total + 0.5);
+    if (target < 1)
+        target = 1;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < HDR_BUCKETS; i++)
+    {
+        seen += counts[i];
+        if (seen >= target)
+            return bucketTop(i) < maxUs ? bucketTop(i) : maxUs;
+    }
+    return maxUs;
+}
+
+// ===================== Telemetry =====================
+
+static const char *const METRIC_NAMES[Telemetry::METRIC_COUNT] = {"cpu", "gpu", "interval", "swap"};
+static const char *const METRIC_HELP[Telemetry::METRIC_COUNT] = {
+    "Tempo de CPU do render por frame, do início até à submissão",
+    "Tempo de GPU por frame (soma das passagens medidas)",
+    "Intervalo entre swaps",
+    "Tempo bloqueado no swap"};
+static const double PERCENTILES[] = {50.0, 90.0, 99.0, 99.9};
+static const int PERCENTILE_COUNT = 4;
+static const int LOG_KEEP = 3; // log.1 .. log.3
+
+Telemetry::Telemetry()
+    : running(false), json(false), period(10.0), maxBytes(1u << 20), log(nullptr), listenFd(-1), frames(0),
+      stopping(false)
+{
+}
+
+Telemetry::~Telemetry()
+{
+    stop();
+}
+
+bool Telemetry::start(const std::string &logFile, const std::string &socketFile, double seconds, size_t bytes)
+{
+    if (running)
+        return true;
+
+    logPath = logFile;
+    socketPath = socketFile;
+    period = seconds > 0.0 ? seconds : 10.0;
+    maxBytes = bytes;
+    json = logPath.size() > 5 && logPath.compare(logPath.size() - 5, 5, ".json") == 0;
+    stopping = false;
+
+    if (!logPath.empty())
+    {
+        log = fopen(logPath.c_str(), "a");
+        if (!log)
+            return false;
+        exporter = std::thread(&Telemetry::exportLoop, this);
+    }
+
+#ifdef __linux__
+    if (!socketPath.empty())
+    {
+        sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, socketPath.c_str(), sizeof(addr.sun_path) - 1);
+
+        // um socket que ficou de uma execução anterior
+        unlink(socketPath.c_str());
+        listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (listenFd < 0 || bind(listenFd, (sockaddr *)&addr, sizeof(addr)) != 0 || listen(listenFd, 4) != 0)
+        {
+            std::cout << "[telemetry] não consegui abrir o socket " << socketPath << "\n";
+            if (listenFd >= 0)
+                close(listenFd);
+            listenFd = -1;
+        }
+        else
+            server = std::thread(&Telemetry::serveLoop, this);
+    }
+#endif
+
+    running = true;
+    return true;
+}
+
+void Telemetry::stop()
+{
+    if (!running)
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(wakeMtx);
+        stopping = true;
+    }
+    wakeCv.notify_all();
+    if (exporter.joinable())
+        exporter.join();
+    if (server.joinable())
+        server.join();
+
+#ifdef __linux__
+    if (listenFd >= 0)
+    {
+        close(listenFd);
+        unlink(socketPath.c_str());
+        listenFd = -1;
+    }
+#endif
+    if (log)
+    {
+        fclose(log);
+        log = nullptr;
+    }
+    running = false;
+}
+
+void Telemetry::recordFrame(float cpuMs, float gpuMs, float intervalMs, float swapMs)
+{
+    if (!running)
+        return;
+
+    std::lock_guard<std::mutex> lock(mtx);
+    float ms[METRIC_COUNT] = {cpuMs, gpuMs, intervalMs, swapMs};
+    for (int m = 0; m < METRIC_COUNT; m++)
+    {
+        if (ms[m] < 0.0f)
+            continue;
+        uint64_t us = (uint64_t)(ms[m] * 1000.0f + 0.5f);
+        window[m].record(us);
+        cumulative[m].record(us);
+    }
+    frames++;
+}
+
+void Telemetry::exportLoop()
+{
+    while (!stopping.load())
+    {
+        {
+            std::unique_lock<std::mutex> lock(wakeMtx);
+            wakeCv.wait_for(lock, std::chrono::duration<double>(period), [this]
+                            { return stopping.load(); });
+        }
+        // também no fim, com o que ficou da última janela
+        writeSummary((double)time(NULL));
+    }
+}
+
+void Telemetry::writeSummary(double now)
+{
+    HdrHistogram snap[METRIC_COUNT];
+    uint64_t frameCount;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (int m = 0; m < METRIC_COUNT; m++)
+        {
+            snap[m] = window[m];
+            window[m].reset();
+        }
+        frameCount = frames;
+    }
+    if (!snap[INTERVAL].count())
+        return; // nada desenhado nesta janela (render a pedido, parado)
+
+    if (ftell(log) == 0 && !json)
+    {
+        fprintf(log, "time,frames_total,window_frames");
+        for (int m = 0; m < METRIC_COUNT; m++)
+            fprintf(log, ",%s_p50_ms,%s_p90_ms,%s_p99_ms,%s_p999_ms,%s_max_ms", METRIC_NAMES[m], METRIC_NAMES[m],
+                    METRIC_NAMES[m], METRIC_NAMES[m], METRIC_NAMES[m]);
+        for (int t = 0; t < MEM_TAG_COUNT; t++)
+            fprintf(log, ",mem_%s_kb", MemTagName((MemTag)t));
+        fprintf(log, ",mem_heap_peak_kb\n");
+    }
+
+    if (json)
+        fprintf(log, "{\"time\": %.0f, \"frames_total\": %llu, \"window_frames\": %llu", now,
+                (unsigned long long)frameCount, (unsigned long long)snap[INTERVAL].count());
+    else
+        fprintf(log, "%.0f,%llu,%llu", now, (unsigned long long)frameCount, (unsigned long long)snap[INTERVAL].count());
+
+    for (int m = 0; m < METRIC_COUNT; m++)
+    {
+        const HdrHistogram &h = snap[m];
+        if (json)
+        {
+            fprintf(log, ", \"%s_ms\": {", METRIC_NAMES[m]);
+            fprintf(log, "\"p50\": %.3f, \"p90\": %.3f, \"p99\": %.3f, \"p999\": %.3f, \"max\": %.3f}",
+                    h.percentile(50.0) / 1000.0, h.percentile(90.0) / 1000.0, h.percentile(99.0) / 1000.0,
+                    h.percentile(99.9) / 1000.0, h.max() / 1000.0);
+        }
+        else
+        {
+            fprintf(log, ",%.3f,%.3f,%.3f,%.3f,%.3f", h.percentile(50.0) / 1000.0, h.percentile(90.0) / 1000.0,
+                    h.percentile(99.0) / 1000.0, h.percentile(99.9) / 1000.0, h.max() / 1000.0);
+        }
+    }
+
+    // memória por tag no fim da janela
+    if (json)
+        fprintf(log, ", \"mem_kb\": {");
+    for (int t = 0; t < MEM_TAG_COUNT; t++)
+    {
+        double kb = MemStats((MemTag)t).current / 1024.0;
+        if (json)
+            fprintf(log, "%s\"%s\": %.1f", t ? ", " : "", MemTagName((MemTag)t), kb);
+        else
+            fprintf(log, ",%.1f", kb);
+    }
+    if (json)
+        fprintf(log, ", \"heap_peak\": %.1f}}\n", MemHeapPeak() / 1024.0);
+    else
+        fprintf(log, ",%.1f\n", MemHeapPeak() / 1024.0);
+    fflush(log);
+
+    if (maxBytes && (size_t)ftell(log) >= maxBytes)
+        rotate();
+}
+
+// log -> log.1 -> log.2 ... (o mais antigo perde-se)
+void Telemetry::rotate()
+{
+    fclose(log);
+    for (int i = LOG_KEEP; i > 1; i--)
+    {
+        std::string from = logPath + "." + std::to_string(i - 1);
+        std::string to = logPath + "." + std::to_string(i);
+        rename(from.c_str(), to.c_str());
+    }
+    rename(logPath.c_str(), (logPath + ".1").c_str());
+    log = fopen(logPath.c_str(), "a");
+    if (!log)
+        log = fopen("/dev/null", "a");
+}
+
+std::string Telemetry::prometheusText()
+{
+    HdrHistogram snap[METRIC_COUNT];
+    uint64_t frameCount;
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        for (int m = 0; m < METRIC_COUNT; m++)
+            snap[m] = cumulative[m];
+        frameCount = frames;
+    }
+
+    std::string out;
+    char line[256];
+    snprintf(line, sizeof(line), "# HELP maze_frames_total Frames apresentados\n# TYPE maze_frames_total counter\n"
+                                 "maze_frames_total %llu\n",
+             (unsigned long long)frameCount);
+    out += line;
+
+    for (int m = 0; m < METRIC_COUNT; m++)
+    {
+        const HdrHistogram &h = snap[m];
+        std::string name = std::string("maze_frame_") + METRIC_NAMES[m] + "_seconds";
+        out += "# HELP " + name + " " + METRIC_HELP[m] + "\n";
+        out += "# TYPE " + name + " summary\n";
+        for (int p = 0; p < PERCENTILE_COUNT; p++)
+        {
+            snprintf(line, sizeof(line), "%s{quantile=\"%g\"} %.6f\n", name.c_str(), PERCENTILES[p] / 100.0,
+                     h.percentile(PERCENTILES[p]) / 1e6);
+            out += line;
+        }
+        snprintf(line, sizeof(line), "%s_sum %.6f\n%s_count %llu\n", name.c_str(), h.mean() * h.count() / 1e6,
+                 name.c_str(), (unsigned long long)h.count());
+        out += line;
+    }
+
+    out += "# HELP maze_memory_bytes Memória viva por subsistema (gl = estimativa da GPU)\n"
+           "# TYPE maze_memory_bytes gauge\n";
+    for (int t = 0; t < MEM_TAG_COUNT; t++)
+    {
+        snprintf(line, sizeof(line), "maze_memory_bytes{tag=\"%s\"} %zu\n", MemTagName((MemTag)t),
+                 MemStats((MemTag)t).current);
+        out += line;
+    }
+    out += "# HELP maze_memory_peak_bytes Pico de memória por subsistema\n# TYPE maze_memory_peak_bytes gauge\n";
+    for (int t = 0; t < MEM_TAG_COUNT; t++)
+    {
+        snprintf(line, sizeof(line), "maze_memory_peak_bytes{tag=\"%s\"} %zu\n", MemTagName((MemTag)t),
+                 MemStats((MemTag)t).peak);
+        out += line;
+    }
+    out += "# HELP maze_memory_allocations_total Alocações por subsistema\n"
+           "# TYPE maze_memory_allocations_total counter\n";
+    for (int t = 0; t < MEM_TAG_COUNT; t++)
+    {
+        snprintf(line, sizeof(line), "maze_memory_allocations_total{tag=\"%s\"} %llu\n", MemTagName((MemTag)t),
+                 (unsigned long long)MemStats((MemTag)t).allocs);
+        out += line;
+    }
+    return out;
+}
+
+void Telemetry::serveLoop()
+{
+#ifdef __linux__
+    while (!stopping.load())
+    {
+        pollfd pfd = {listenFd, POLLIN, 0};
+        if (poll(&pfd, 1, 200) <= 0)
+            continue;
+        int client = accept(listenFd, nullptr, nullptr);
+        if (client < 0)
+            continue;
+
+        // o pedido (se houver) só serve para saber se é HTTP
+        char request[1024];
+        ssize_t got = 0;
+        pollfd cfd = {client, POLLIN, 0};
+        if (poll(&cfd, 1, 100) > 0)
+            got = recv(client, request, sizeof(request) - 1, 0);
+
+        std::string body = prometheusText();
+        std::string reply;
+        if (got >= 4 && memcmp(request, "GET ", 4) == 0)
+            reply = "HTTP/1.0 200 OK\r\nContent-Type: text/plain; version=0.0.4\r\nContent-Length: " +
+                    std::to_string(body.size()) + "\r\n\r\n";
+        reply += body;
+
+        size_t sent = 0;
+        while (sent < reply.size())
+        {
+            ssize_t n = send(client, reply.data() + sent, reply.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0)
+                break;
+            sent += (size_t)n;
+        }
+        close(client);
+    }
+#endif
+}
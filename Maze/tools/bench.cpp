@@ -0,0 +1,331 @@
+// bench: microbenchmarks dos caminhos quentes do jogo que não precisam de GL
+//
+//   bench [--reps n] [--warmup n] [--filter texto] [--json out.json]
+//         [--baseline base.json] [--threshold pct]
+//
+// Cada benchmark corre `warmup` vezes sem medir e depois `reps` vezes, cada uma cronometrada
+// à parte; o relatório (terminal e JSON) tem mínimo, mediana, média, p95, máximo e desvio
+// padrão. Com --baseline compara cada benchmark com o ficheiro guardado e sai com código 1 se
+// algum piorou mais que --threshold por cento (10 por omissão) na mediana e também no mínimo
+// (só a mediana dá falsos alarmes quando a máquina tem um soluço a meio da corrida).
+// Corre a partir da pasta Maze/ (lê ./meshes, ./textures e ./sounds).
+
+#include <./include/asset_loader.h>
+#include <./include/maze_grid.h>
+#include <./include/objloader.hpp>
+#include <./include/profiler.h>
+#include <./include/stb_image.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <map>
+#include <string>
+#include <vector>
+
+typedef std::chrono::steady_clock BenchClock;
+
+struct BenchResult
+{
+    std::string name;
+    int reps = 0;
+    double minNs = 0, medianNs = 0, meanNs = 0, p95Ns = 0, maxNs = 0, stddevNs = 0;
+};
+
+struct BenchOptions
+{
+    int reps = 30;
+    int warmup = 3;
+    const char *filter = nullptr;
+    const char *jsonPath = "./outputs/bench.json";
+    const char *baselinePath = nullptr;
+    double threshold = 10.0;
+};
+
+static BenchOptions gOptions;
+static std::vector<BenchResult> gResults;
+
+// o compilador não pode deitar fora o trabalho cujo resultado acaba aqui
+static volatile long long gSink = 0;
+
+// repsScale: benchmarks lentos correm menos vezes (mínimo 3)
+static void Run(const char *name, double repsScale, const std::function<void()> &fn)
+{
+    if (gOptions.filter && !strstr(name, gOptions.filter))
+        return;
+
+    int reps = std::max(3, (int)(gOptions.reps * repsScale));
+    for (int i = 0; i < gOptions.warmup; i++)
+        fn();
+
+    std::vector<double> ns(reps);
+    for (int i = 0; i < reps; i++)
+    {
+        BenchClock::time_point t0 = BenchClock::now();
+        fn();
+        ns[i] = std::chrono::duration<double, std::nano>(BenchClock::now() - t0).count();
+    }
+    std::sort(ns.begin(), ns.end());
+
+    BenchResult r;
+    r.name = name;
+    r.reps = reps;
+    r.minNs = ns.front();
+    r.maxNs = ns.back();
+    r.medianNs = reps % 2 ? ns[reps / 2] : 0.5 * (ns[reps / 2 - 1] + ns[reps / 2]);
+    r.p95Ns = ns[std::min(reps - 1, reps * 95 / 100)];
+    double sum = 0.0;
+    for (int i = 0; i < reps; i++)
+        sum += ns[i];
+    r.meanNs = sum / reps;
+    double var = 0.0;
+    for (int i = 0; i < reps; i++)
+        var += (ns[i] - r.meanNs) * (ns[i] - r.meanNs);
+    r.stddevNs = reps > 1 ? sqrt(var / (reps - 1)) : 0.0;
+    gResults.push_back(r);
+
+    printf("%-40s %5d reps  mediana %12.1f us  min %12.1f  p95 %12.1f  ±%.1f%%\n", name, reps, r.medianNs / 1000.0,
+           r.minNs / 1000.0, r.p95Ns / 1000.0, r.meanNs > 0 ? 100.0 * r.stddevNs / r.meanNs : 0.0);
+}
+
+// ===================== Benchmarks =====================
+
+// uma arena para todos os labirintos, como o jogo entre níveis
+static LevelArena gArena;
+
+static void BenchMaze()
+{
+    static const int sizes[] = {21, 101, 501};
+    static const double scale[] = {1.0, 1.0, 0.2};
+    for (int i = 0; i < 3; i++)
+    {
+        int size = sizes[i];
+        std::string name = "generateMaze/" + std::to_string(size);
+        Run(name.c_str(), scale[i], [size]
+            {
+                MAZE_W = MAZE_H = size;
+                gArena.reset();
+                gArena.reserve(LevelArenaBytes(size, size));
+                srand(1);
+                generateMaze(gArena);
+                gSink += maze[size / 2][size / 2]; });
+    }
+}
+
+static void BenchCollision()
+{
+    // labirinto fixo e posições pseudo-aleatórias (as mesmas em todas as corridas)
+    MAZE_W = MAZE_H = 101;
+    gArena.reset();
+    gArena.reserve(LevelArenaBytes(MAZE_W, MAZE_H));
+    srand(1);
+    generateMaze(gArena);
+
+    std::vector<glm::vec3> points(10000);
+    unsigned state = 12345;
+    for (size_t i = 0; i < points.size(); i++)
+    {
+        state = state * 1664525u + 1013904223u;
+        float x = (state >> 8) / 16777216.0f * MAZE_W * CELL_SIZE;
+        state = state * 1664525u + 1013904223u;
+        float z = (state >> 8) / 16777216.0f * MAZE_H * CELL_SIZE;
+        points[i] = glm::vec3(x, 0.5f, z);
+    }
+
+    Run("checkCollision/10000", 1.0, [&points]
+        {
+            int hits = 0;
+            for (size_t i = 0; i < points.size(); i++)
+                hits += checkCollision(points[i]);
+            gSink += hits; });
+}
+
+static void BenchMesh(const char *file)
+{
+    std::string path = std::string("./meshes/") + file;
+    std::string name = std::string("loadOBJ/") + file;
+    Run(name.c_str(), 1.0, [&path]
+        {
+            MeshVector<glm::vec3> vertices, normals;
+            MeshVector<glm::vec2> uvs;
+            loadOBJ(path.c_str(), vertices, uvs, normals);
+            gSink += vertices.size(); });
+
+    name = std::string("loadMeshFromFile/") + file;
+    Run(name.c_str(), 1.0, [&path]
+        {
+            DecodedMesh mesh;
+            loadMeshFromFile(path.c_str(), mesh.bufferData, mesh.vertices, mesh.uvs, mesh.normals);
+            gSink += mesh.bufferData.size(); });
+}
+
+static void BenchTexture(const char *file)
+{
+    std::string path = std::string("./textures/") + file;
+    std::string name = std::string("stbi_load/") + file;
+    Run(name.c_str(), 0.5, [&path]
+        {
+            stbi_set_flip_vertically_on_load(true);
+            int w = 0, h = 0, n = 0;
+            unsigned char *pixels = stbi_load(path.c_str(), &w, &h, &n, 0);
+            gSink += w * h;
+            stbi_image_free(pixels); });
+}
+
+static void BenchWav(const char *file)
+{
+    std::string path = std::string("./sounds/") + file;
+    std::string name = std::string("DecodeWav/") + file;
+    Run(name.c_str(), 1.0, [&path]
+        {
+            DecodedSound sound;
+            DecodeWav(path.c_str(), sound);
+            gSink += sound.samples.size(); });
+}
+
+// ===================== JSON / baseline =====================
+
+static bool WriteJson(const char *path)
+{
+    FILE *f = fopen(path, "w");
+    if (!f)
+        return false;
+
+    // um benchmark por linha (o --baseline lê-o linha a linha)
+    fprintf(f, "{\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < gResults.size(); i++)
+    {
+        const BenchResult &r = gResults[i];
+        fprintf(f,
+                "    {\"name\": \"%s\", \"reps\": %d, \"min_ns\": %.1f, \"median_ns\": %.1f, \"mean_ns\": %.1f, "
+                "\"p95_ns\": %.1f, \"max_ns\": %.1f, \"stddev_ns\": %.1f}%s\n",
+                r.name.c_str(), r.reps, r.minNs, r.medianNs, r.meanNs, r.p95Ns, r.maxNs, r.stddevNs,
+                i + 1 < gResults.size() ? "," : "");
+    }
+    fprintf(f, "  ]\n}\n");
+    fclose(f);
+    return true;
+}
+
+struct BaselineEntry
+{
+    double minNs, medianNs;
+};
+
+// nome -> tempos, de um JSON escrito por WriteJson
+static bool ReadBaseline(const char *path, std::map<std::string, BaselineEntry> &out)
+{
+    FILE *f = fopen(path, "r");
+    if (!f)
+        return false;
+
+    char line[1024];
+    while (fgets(line, sizeof(line), f))
+    {
+        const char *name = strstr(line, "\"name\": \"");
+        const char *min = strstr(line, "\"min_ns\": ");
+        const char *median = strstr(line, "\"median_ns\": ");
+        if (!name || !min || !median)
+            continue;
+        name += 9;
+        const char *end = strchr(name, '"');
+        if (!end)
+            continue;
+        BaselineEntry e = {atof(min + 10), atof(median + 13)};
+        out[std::string(name, end)] = e;
+    }
+    fclose(f);
+    return true;
+}
+
+// devolve o número de regressões
+static int CompareBaseline(const std::map<std::string, BaselineEntry> &baseline, double thresholdPct)
+{
+    int regressions = 0;
+    printf("\ncomparação com %s (limite +%.1f%%)\n", gOptions.baselinePath, thresholdPct);
+    for (size_t i = 0; i < gResults.size(); i++)
+    {
+        const BenchResult &r = gResults[i];
+        std::map<std::string, BaselineEntry>::const_iterator it = baseline.find(r.name);
+        if (it == baseline.end() || it->second.medianNs <= 0.0 || it->second.minNs <= 0.0)
+        {
+            printf("  %-40s (novo)\n", r.name.c_str());
+            continue;
+        }
+        const BaselineEntry &base = it->second;
+        double change = 100.0 * (r.medianNs - base.medianNs) / base.medianNs;
+        double minChange = 100.0 * (r.minNs - base.minNs) / base.minNs;
+        const char *tag = "";
+        if (change > thresholdPct && minChange > thresholdPct)
+        {
+            tag = "  <-- REGRESSÃO";
+            regressions++;
+        }
+        else if (change < -thresholdPct)
+            tag = "  (melhor)";
+        printf("  %-40s %12.1f -> %12.1f us  %+7.1f%%%s\n", r.name.c_str(), base.medianNs / 1000.0, r.medianNs / 1000.0,
+               change, tag);
+    }
+    return regressions;
+}
+
+int main(int argc, char **argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        bool hasValue = i + 1 < argc;
+        if (strcmp(argv[i], "--reps") == 0 && hasValue)
+            gOptions.reps = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--warmup") == 0 && hasValue)
+            gOptions.warmup = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--filter") == 0 && hasValue)
+            gOptions.filter = argv[++i];
+        else if (strcmp(argv[i], "--json") == 0 && hasValue)
+            gOptions.jsonPath = argv[++i];
+        else if (strcmp(argv[i], "--baseline") == 0 && hasValue)
+            gOptions.baselinePath = argv[++i];
+        else if (strcmp(argv[i], "--threshold") == 0 && hasValue)
+            gOptions.threshold = atof(argv[++i]);
+        else
+        {
+            printf("uso: bench [--reps n] [--warmup n] [--filter texto] [--json out.json] [--baseline base.json] "
+                   "[--threshold pct]\n");
+            return 2;
+        }
+    }
+
+    // sem o custo das zonas do profiler (generateMaze, checkCollision, ...)
+    Profiler::setEnabled(false);
+
+    BenchMaze();
+    BenchCollision();
+    BenchMesh("wall.obj");
+    BenchTexture("bricks_wall_texture.png");
+    BenchWav("step.wav");
+
+    if (!WriteJson(gOptions.jsonPath))
+        printf("bench: não consegui escrever %s\n", gOptions.jsonPath);
+    else
+        printf("\nresultados em %s\n", gOptions.jsonPath);
+
+    if (gOptions.baselinePath)
+    {
+        std::map<std::string, BaselineEntry> baseline;
+        if (!ReadBaseline(gOptions.baselinePath, baseline))
+        {
+            printf("bench: não consegui ler %s\n", gOptions.baselinePath);
+            return 2;
+        }
+        int regressions = CompareBaseline(baseline, gOptions.threshold);
+        if (regressions)
+        {
+            printf("%d regressões\n", regressions);
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+// embed: gera um .cpp que embute ficheiros no executável (make embedded)
+//
+//   embed <out.cpp> <ficheiro|pasta>...
+//
+// Cada ficheiro fica num array constante alinhado a 16 bytes (via .incbin, para não gerar
+// dezenas de MB de texto) e entra na tabela gEmbeddedAssets usada por ReadAsset().
+// Os caminhos são guardados tal como aparecem na linha de comandos (relativos a Maze/).
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <dirent.h>
+#include <sys/stat.h>
+
+static void CollectFiles(const std::string &path, std::vector<std::string> &out)
+{
+    struct stat st;
+    if (stat(path.c_str(), &st) != 0)
+    {
+        printf("embed: %s não existe\n", path.c_str());
+        return;
+    }
+
+    if (!S_ISDIR(st.st_mode))
+    {
+        out.push_back(path);
+        return;
+    }
+
+    DIR *dir = opendir(path.c_str());
+    if (!dir)
+        return;
+
+    std::vector<std::string> names;
+    while (struct dirent *entry = readdir(dir))
+    {
+        std::string name = entry->d_name;
+        if (name != "." && name != "..")
+            names.push_back(name);
+    }
+    closedir(dir);
+
+    // ordem estável entre builds
+    std::sort(names.begin(), names.end());
+    for (size_t i = 0; i < names.size(); i++)
+        CollectFiles(path + "/" + names[i], out);
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 3)
+    {
+        printf("uso: embed <out.cpp> <ficheiro|pasta>...\n");
+        return 1;
+    }
+
+    std::vector<std::string> files;
+    for (int i = 2; i < argc; i++)
+        CollectFiles(argv[i], files);
+
+    FILE *out = fopen(argv[1], "w");
+    if (!out)
+    {
+        printf("embed: erro a escrever %s\n", argv[1]);
+        return 1;
+    }
+
+    fprintf(out, "// Gerado por tools/embed - não editar\n");
+    fprintf(out, "#include <cstddef>\n\n");
+    fprintf(out, "#ifdef __APPLE__\n");
+    fprintf(out, "#define EMBED_SECTION \".const_data\\n\"\n");
+    fprintf(out, "#define EMBED_SYMBOL(name) \"_\" name\n");
+    fprintf(out, "#else\n");
+    fprintf(out, "#define EMBED_SECTION \".section .rodata\\n\"\n");
+    fprintf(out, "#define EMBED_SYMBOL(name) name\n");
+    fprintf(out, "#endif\n\n");
+
+    std::vector<long> sizes;
+    for (size_t i = 0; i < files.size(); i++)
+    {
+        struct stat st;
+        stat(files[i].c_str(), &st);
+        sizes.push_back((long)st.st_size);
+
+        // + 1 byte a zero no fim (texto pode ser lido como string C)
+        fprintf(out, "__asm__(EMBED_SECTION\n");
+        fprintf(out, "        \".balign 16\\n\"\n");
+        fprintf(out, "        \".globl \" EMBED_SYMBOL(\"maze_asset_%zu\") \"\\n\"\n", i);
+        fprintf(out, "        EMBED_SYMBOL(\"maze_asset_%zu\") \":\\n\"\n", i);
+        fprintf(out, "        \".incbin \\\"%s\\\"\\n\"\n", files[i].c_str());
+        fprintf(out, "        \".byte 0\\n\"\n");
+        fprintf(out, "        \".previous\\n\");\n");
+        fprintf(out, "extern \"C\" const unsigned char maze_asset_%zu[];\n\n", i);
+    }
+
+    fprintf(out, "struct EmbeddedAsset\n{\n    const char *path;\n    const unsigned char *data;\n    size_t size;\n};\n\n");
+    fprintf(out, "extern const EmbeddedAsset gEmbeddedAssets[] = {\n");
+    for (size_t i = 0; i < files.size(); i++)
+        fprintf(out, "    {\"%s\", maze_asset_%zu, %ld},\n", files[i].c_str(), i, sizes[i]);
+    fprintf(out, "    {nullptr, nullptr, 0}};\n\n");
+    fprintf(out, "extern const size_t gEmbeddedAssetCount = %zu;\n", files.size());
+
+    fclose(out);
+    printf("embed: %zu ficheiros em %s\n", files.size(), argv[1]);
+    return 0;
+}
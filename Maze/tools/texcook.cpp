@@ -0,0 +1,560 @@
+// texcook: converte um PNG numa textura KTX pré-comprimida com a cadeia de mipmaps já gerada
+//
+//   texcook [-j threads] <in.png> <out_dir>
+//
+// Escreve <out_dir>/<nome>.bc.ktx (BC1 se a imagem for opaca, BC3 se tiver alpha) e,
+// para imagens opacas, <out_dir>/<nome>.etc2.ktx (ETC2 RGB, para drivers sem S3TC).
+// As imagens são invertidas na vertical como no stbi_load do jogo, por isso os dados
+// ficam já na ordem do upload GL.
+
+#include <./include/ktx.h>
+#include <./include/stb_image.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+struct Image
+{
+    int w = 0;
+    int h = 0;
+    std::vector<unsigned char> rgba;
+};
+
+enum BlockFormat
+{
+    FORMAT_BC1,
+    FORMAT_BC3,
+    FORMAT_ETC2_RGB
+};
+
+// ===================== Mipmaps =====================
+
+static Image Downsample(const Image &src)
+{
+    Image dst;
+    dst.w = std::max(1, src.w / 2);
+    dst.h = std::max(1, src.h / 2);
+    dst.rgba.resize((size_t)dst.w * dst.h * 4);
+
+    for (int y = 0; y < dst.h; y++)
+    {
+        int y0 = std::min(y * 2, src.h - 1);
+        int y1 = std::min(y * 2 + 1, src.h - 1);
+        for (int x = 0; x < dst.w; x++)
+        {
+            int x0 = std::min(x * 2, src.w - 1);
+            int x1 = std::min(x * 2 + 1, src.w - 1);
+
+            const unsigned char *a = &src.rgba[((size_t)y0 * src.w + x0) * 4];
+            const unsigned char *b = &src.rgba[((size_t)y0 * src.w + x1) * 4];
+            const unsigned char *c = &src.rgba[((size_t)y1 * src.w + x0) * 4];
+            const unsigned char *d = &src.rgba[((size_t)y1 * src.w + x1) * 4];
+            unsigned char *o = &dst.rgba[((size_t)y * dst.w + x) * 4];
+
+            for (int ch = 0; ch < 4; ch++)
+                o[ch] = (unsigned char)((a[ch] + b[ch] + c[ch] + d[ch] + 2) / 4);
+        }
+    }
+    return dst;
+}
+
+// ===================== Blocos 4x4 =====================
+
+// Copia o bloco (bx,by) para 16 píxeis RGBA contíguos (repete a última linha/coluna nas margens)
+static void FetchBlock(const Image &img, int bx, int by, unsigned char *block)
+{
+    for (int y = 0; y < 4; y++)
+    {
+        int sy = std::min(by * 4 + y, img.h - 1);
+        for (int x = 0; x < 4; x++)
+        {
+            int sx = std::min(bx * 4 + x, img.w - 1);
+            memcpy(block + (y * 4 + x) * 4, &img.rgba[((size_t)sy * img.w + sx) * 4], 4);
+        }
+    }
+}
+
+// Mínimo e máximo por canal dos 16 píxeis do bloco
+static void BlockMinMax(const unsigned char *block, unsigned char mn[4], unsigned char mx[4])
+{
+#ifdef __SSE2__
+    __m128i r0 = _mm_load_si128((const __m128i *)(block + 0));
+    __m128i r1 = _mm_load_si128((const __m128i *)(block + 16));
+    __m128i r2 = _mm_load_si128((const __m128i *)(block + 32));
+    __m128i r3 = _mm_load_si128((const __m128i *)(block + 48));
+
+    __m128i lo = _mm_min_epu8(_mm_min_epu8(r0, r1), _mm_min_epu8(r2, r3));
+    __m128i hi = _mm_max_epu8(_mm_max_epu8(r0, r1), _mm_max_epu8(r2, r3));
+
+    // reduzir os 4 píxeis de cada registo
+    lo = _mm_min_epu8(lo, _mm_shuffle_epi32(lo, _MM_SHUFFLE(1, 0, 3, 2)));
+    lo = _mm_min_epu8(lo, _mm_shuffle_epi32(lo, _MM_SHUFFLE(2, 3, 0, 1)));
+    hi = _mm_max_epu8(hi, _mm_shuffle_epi32(hi, _MM_SHUFFLE(1, 0, 3, 2)));
+    hi = _mm_max_epu8(hi, _mm_shuffle_epi32(hi, _MM_SHUFFLE(2, 3, 0, 1)));
+
+    int l = _mm_cvtsi128_si32(lo);
+    int h = _mm_cvtsi128_si32(hi);
+    memcpy(mn, &l, 4);
+    memcpy(mx, &h, 4);
+#else
+    for (int c = 0; c < 4; c++)
+    {
+        mn[c] = 255;
+        mx[c] = 0;
+    }
+    for (int i = 0; i < 16; i++)
+    {
+        for (int c = 0; c < 4; c++)
+        {
+            mn[c] = std::min(mn[c], block[i * 4 + c]);
+            mx[c] = std::max(mx[c], block[i * 4 + c]);
+        }
+    }
+#endif
+}
+
+static int ColorDistance(const unsigned char *p, const int c[3])
+{
+    int dr = p[0] - c[0];
+    int dg = p[1] - c[1];
+    int db = p[2] - c[2];
+    return dr * dr + dg * dg + db * db;
+}
+
+// ===================== BC1 / BC3 =====================
+
+static unsigned short To565(int r, int g, int b)
+{
+    return (unsigned short)((((r * 31 + 127) / 255) << 11) | (((g * 63 + 127) / 255) << 5) | ((b * 31 + 127) / 255));
+}
+
+static void From565(unsigned short c, int rgb[3])
+{
+    int r = (c >> 11) & 31;
+    int g = (c >> 5) & 63;
+    int b = c & 31;
+    rgb[0] = (r << 3) | (r >> 2);
+    rgb[1] = (g << 2) | (g >> 4);
+    rgb[2] = (b << 3) | (b >> 2);
+}
+
+// Bloco de cor BC1 (modo de 4 cores) por "range fit" na caixa RGB do bloco
+static void EncodeColorBlock(const unsigned char *block, const unsigned char mn[4], const unsigned char mx[4], unsigned char *out)
+{
+    int lo[3], hi[3];
+    for (int c = 0; c < 3; c++)
+    {
+        // encolher a caixa 1/16 de cada lado (menos erro nas pontas)
+        int inset = (mx[c] - mn[c]) >> 4;
+        lo[c] = mn[c] + inset;
+        hi[c] = mx[c] - inset;
+    }
+
+    unsigned short c0 = To565(hi[0], hi[1], hi[2]);
+    unsigned short c1 = To565(lo[0], lo[1], lo[2]);
+    if (c0 < c1)
+        std::swap(c0, c1);
+
+    unsigned int indices = 0;
+    if (c0 != c1)
+    {
+        int pal[4][3];
+        From565(c0, pal[0]);
+        From565(c1, pal[1]);
+        for (int c = 0; c < 3; c++)
+        {
+            pal[2][c] = (2 * pal[0][c] + pal[1][c]) / 3;
+            pal[3][c] = (pal[0][c] + 2 * pal[1][c]) / 3;
+        }
+
+        for (int i = 0; i < 16; i++)
+        {
+            int best = 0;
+            int bestErr = ColorDistance(block + i * 4, pal[0]);
+            for (int k = 1; k < 4; k++)
+            {
+                int err = ColorDistance(block + i * 4, pal[k]);
+                if (err < bestErr)
+                {
+                    bestErr = err;
+                    best = k;
+                }
+            }
+            indices |= (unsigned int)best << (2 * i);
+        }
+    }
+
+    out[0] = (unsigned char)(c0 & 0xFF);
+    out[1] = (unsigned char)(c0 >> 8);
+    out[2] = (unsigned char)(c1 & 0xFF);
+    out[3] = (unsigned char)(c1 >> 8);
+    for (int b = 0; b < 4; b++)
+        out[4 + b] = (unsigned char)(indices >> (8 * b));
+}
+
+// Bloco de alpha BC3 (modo de 8 valores entre o mínimo e o máximo)
+static void EncodeAlphaBlock(const unsigned char *block, unsigned char a0, unsigned char a1, unsigned char *out)
+{
+    int pal[8];
+    pal[0] = a0;
+    pal[1] = a1;
+    for (int k = 1; k <= 6; k++)
+        pal[k + 1] = ((7 - k) * a0 + k * a1) / 7;
+
+    unsigned long long bits = 0;
+    if (a0 != a1)
+    {
+        for (int i = 0; i < 16; i++)
+        {
+            int a = block[i * 4 + 3];
+            int best = 0;
+            for (int k = 1; k < 8; k++)
+            {
+                if (abs(a - pal[k]) < abs(a - pal[best]))
+                    best = k;
+            }
+            bits |= (unsigned long long)best << (3 * i);
+        }
+    }
+
+    out[0] = a0;
+    out[1] = a1;
+    for (int b = 0; b < 6; b++)
+        out[2 + b] = (unsigned char)(bits >> (8 * b));
+}
+
+// ===================== ETC2 RGB (blocos compatíveis com ETC1) =====================
+
+static const int ETC_MODIFIERS[8][2] = {{2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+
+static int Clamp255(int v)
+{
+    return v < 0 ? 0 : (v > 255 ? 255 : v);
+}
+
+// Melhor tabela para uma sub-bloco com a cor base dada; devolve o erro e preenche os índices
+static int EtcBestTable(const unsigned char *block, const int *pixels, const int base[3], int &table, int idx[8])
+{
+    int bestErr = -1;
+    for (int t = 0; t < 8; t++)
+    {
+        int mods[4] = {ETC_MODIFIERS[t][0], ETC_MODIFIERS[t][1], -ETC_MODIFIERS[t][0], -ETC_MODIFIERS[t][1]};
+        int err = 0;
+        int tIdx[8];
+        for (int p = 0; p < 8; p++)
+        {
+            const unsigned char *px = block + pixels[p] * 4;
+            int pBest = 0, pErr = -1;
+            for (int m = 0; m < 4; m++)
+            {
+                int c[3] = {Clamp255(base[0] + mods[m]), Clamp255(base[1] + mods[m]), Clamp255(base[2] + mods[m])};
+                int e = ColorDistance(px, c);
+                if (pErr < 0 || e < pErr)
+                {
+                    pErr = e;
+                    pBest = m;
+                }
+            }
+            tIdx[p] = pBest;
+            err += pErr;
+        }
+        if (bestErr < 0 || err < bestErr)
+        {
+            bestErr = err;
+            table = t;
+            memcpy(idx, tIdx, sizeof(tIdx));
+        }
+    }
+    return bestErr;
+}
+
+static void EncodeEtcBlock(const unsigned char *block, unsigned char *out)
+{
+    unsigned int bestHi = 0, bestLo = 0;
+    int bestErr = -1;
+
+    for (int flip = 0; flip < 2; flip++)
+    {
+        // píxeis (índice no bloco y*4+x) de cada sub-bloco
+        int sub[2][8];
+        int n0 = 0, n1 = 0;
+        for (int y = 0; y < 4; y++)
+        {
+            for (int x = 0; x < 4; x++)
+            {
+                bool first = flip ? (y < 2) : (x < 2);
+                if (first)
+                    sub[0][n0++] = y * 4 + x;
+                else
+                    sub[1][n1++] = y * 4 + x;
+            }
+        }
+
+        int avg[2][3];
+        for (int s = 0; s < 2; s++)
+        {
+            for (int c = 0; c < 3; c++)
+            {
+                int sum = 0;
+                for (int p = 0; p < 8; p++)
+                    sum += block[sub[s][p] * 4 + c];
+                avg[s][c] = (sum + 4) / 8;
+            }
+        }
+
+        // modo diferencial (5 bits + delta de 3 bits) se as médias estiverem perto, senão individual (4 bits)
+        int q[2][3];
+        bool diff = true;
+        for (int c = 0; c < 3; c++)
+        {
+            q[0][c] = (avg[0][c] * 31 + 127) / 255;
+            q[1][c] = (avg[1][c] * 31 + 127) / 255;
+            int d = q[1][c] - q[0][c];
+            if (d < -4 || d > 3)
+                diff = false;
+        }
+
+        int base[2][3];
+        if (diff)
+        {
+            for (int s = 0; s < 2; s++)
+                for (int c = 0; c < 3; c++)
+                    base[s][c] = (q[s][c] << 3) | (q[s][c] >> 2);
+        }
+        else
+        {
+            for (int s = 0; s < 2; s++)
+            {
+                for (int c = 0; c < 3; c++)
+                {
+                    q[s][c] = (avg[s][c] * 15 + 127) / 255;
+                    base[s][c] = (q[s][c] << 4) | q[s][c];
+                }
+            }
+        }
+
+        int table[2];
+        int idx[2][8];
+        int err = EtcBestTable(block, sub[0], base[0], table[0], idx[0]) +
+                  EtcBestTable(block, sub[1], base[1], table[1], idx[1]);
+
+        if (bestErr >= 0 && err >= bestErr)
+            continue;
+        bestErr = err;
+
+        unsigned int hi;
+        if (diff)
+        {
+            hi = ((unsigned int)q[0][0] << 27) | ((unsigned int)((q[1][0] - q[0][0]) & 7) << 24) |
+                 ((unsigned int)q[0][1] << 19) | ((unsigned int)((q[1][1] - q[0][1]) & 7) << 16) |
+                 ((unsigned int)q[0][2] << 11) | ((unsigned int)((q[1][2] - q[0][2]) & 7) << 8) | (1u << 1);
+        }
+        else
+        {
+            hi = ((unsigned int)q[0][0] << 28) | ((unsigned int)q[1][0] << 24) |
+                 ((unsigned int)q[0][1] << 20) | ((unsigned int)q[1][1] << 16) |
+                 ((unsigned int)q[0][2] << 12) | ((unsigned int)q[1][2] << 8);
+        }
+        hi |= ((unsigned int)table[0] << 5) | ((unsigned int)table[1] << 2) | (unsigned int)flip;
+
+        // índices por coluna (i = x*4 + y): MSB nos bits 16..31, LSB nos bits 0..15
+        unsigned int lo = 0;
+        for (int s = 0; s < 2; s++)
+        {
+            for (int p = 0; p < 8; p++)
+            {
+                int x = sub[s][p] % 4;
+                int y = sub[s][p] / 4;
+                int i = x * 4 + y;
+                lo |= (unsigned int)((idx[s][p] >> 1) & 1) << (16 + i);
+                lo |= (unsigned int)(idx[s][p] & 1) << i;
+            }
+        }
+
+        bestHi = hi;
+        bestLo = lo;
+    }
+
+    for (int b = 0; b < 4; b++)
+    {
+        out[b] = (unsigned char)(bestHi >> (24 - 8 * b));
+        out[4 + b] = (unsigned char)(bestLo >> (24 - 8 * b));
+    }
+}
+
+// ===================== Codificação de um nível =====================
+
+static size_t BlockBytes(BlockFormat format)
+{
+    return format == FORMAT_BC3 ? 16 : 8;
+}
+
+static void EncodeRows(const Image &img, BlockFormat format, int rowBegin, int rowEnd, unsigned char *out)
+{
+    int blocksX = (img.w + 3) / 4;
+    size_t stride = BlockBytes(format);
+
+    alignas(16) unsigned char block[64];
+    unsigned char mn[4], mx[4];
+
+    for (int by = rowBegin; by < rowEnd; by++)
+    {
+        for (int bx = 0; bx < blocksX; bx++)
+        {
+            unsigned char *dst = out + ((size_t)by * blocksX + bx) * stride;
+            FetchBlock(img, bx, by, block);
+
+            if (format == FORMAT_ETC2_RGB)
+            {
+                EncodeEtcBlock(block, dst);
+                continue;
+            }
+
+            BlockMinMax(block, mn, mx);
+            if (format == FORMAT_BC3)
+            {
+                EncodeAlphaBlock(block, mx[3], mn[3], dst);
+                dst += 8;
+            }
+            EncodeColorBlock(block, mn, mx, dst);
+        }
+    }
+}
+
+// Divide as linhas de blocos pelas threads (cada uma escreve na sua parte do buffer)
+static TextureBytes EncodeLevel(const Image &img, BlockFormat format, unsigned int threadCount)
+{
+    int blocksX = (img.w + 3) / 4;
+    int blocksY = (img.h + 3) / 4;
+    TextureBytes out((size_t)blocksX * blocksY * BlockBytes(format));
+
+    unsigned int n = std::max(1u, std::min(threadCount, (unsigned int)blocksY));
+    std::vector<std::thread> workers;
+    for (unsigned int t = 0; t < n; t++)
+    {
+        int begin = (int)(blocksY * t / n);
+        int end = (int)(blocksY * (t + 1) / n);
+        workers.push_back(std::thread(EncodeRows, std::cref(img), format, begin, end, out.data()));
+    }
+    for (size_t t = 0; t < workers.size(); t++)
+        workers[t].join();
+
+    return out;
+}
+
+static bool Cook(const std::vector<Image> &mips, BlockFormat format, unsigned int threads, const std::string &path)
+{
+    KtxTexture ktx;
+    ktx.width = mips[0].w;
+    ktx.height = mips[0].h;
+
+    if (format == FORMAT_BC1)
+    {
+        ktx.glInternalFormat = KTX_COMPRESSED_RGB_S3TC_DXT1;
+        ktx.glBaseInternalFormat = KTX_BASE_RGB;
+    }
+    else if (format == FORMAT_BC3)
+    {
+        ktx.glInternalFormat = KTX_COMPRESSED_RGBA_S3TC_DXT5;
+        ktx.glBaseInternalFormat = KTX_BASE_RGBA;
+    }
+    else
+    {
+        ktx.glInternalFormat = KTX_COMPRESSED_RGB8_ETC2;
+        ktx.glBaseInternalFormat = KTX_BASE_RGB;
+    }
+
+    size_t bytes = 0;
+    for (size_t i = 0; i < mips.size(); i++)
+    {
+        ktx.levels.push_back(EncodeLevel(mips[i], format, threads));
+        bytes += ktx.levels.back().size();
+    }
+
+    if (!SaveKTX(path.c_str(), ktx))
+    {
+        printf("texcook: erro a escrever %s\n", path.c_str());
+        return false;
+    }
+
+    size_t rawBytes = (size_t)mips[0].w * mips[0].h * 4 * 4 / 3;
+    printf("texcook: %s  %dx%d, %d mips, %zu KB (RGBA8 com mips: %zu KB)\n",
+           path.c_str(), ktx.width, ktx.height, (int)mips.size(), bytes / 1024, rawBytes / 1024);
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    unsigned int threads = std::thread::hardware_concurrency();
+    int arg = 1;
+    if (argc > 2 && strcmp(argv[1], "-j") == 0)
+    {
+        threads = (unsigned int)atoi(argv[2]);
+        arg = 3;
+    }
+    if (threads == 0)
+        threads = 1;
+
+    if (argc - arg != 2)
+    {
+        printf("uso: texcook [-j threads] <in.png> <out_dir>\n");
+        return 1;
+    }
+
+    const char *inPath = argv[arg];
+    std::string outDir = argv[arg + 1];
+
+    // mesma orientação que o jogo (stbi com flip vertical)
+    stbi_set_flip_vertically_on_load(true);
+
+    Image base;
+    int n;
+    unsigned char *data = stbi_load(inPath, &base.w, &base.h, &n, 4);
+    if (!data)
+    {
+        printf("texcook: falha a carregar %s\n", inPath);
+        return 1;
+    }
+    base.rgba.assign(data, data + (size_t)base.w * base.h * 4);
+    stbi_image_free(data);
+
+    bool opaque = true;
+    for (size_t i = 3; i < base.rgba.size(); i += 4)
+    {
+        if (base.rgba[i] != 255)
+        {
+            opaque = false;
+            break;
+        }
+    }
+
+    // cadeia de mipmaps completa (até 1x1)
+    std::vector<Image> mips;
+    mips.push_back(base);
+    while (mips.back().w > 1 || mips.back().h > 1)
+        mips.push_back(Downsample(mips.back()));
+
+    std::string name = inPath;
+    size_t slash = name.find_last_of('/');
+    if (slash != std::string::npos)
+        name = name.substr(slash + 1);
+    size_t dot = name.find_last_of('.');
+    if (dot != std::string::npos)
+        name = name.substr(0, dot);
+
+    if (!Cook(mips, opaque ? FORMAT_BC1 : FORMAT_BC3, threads, outDir + "/" + name + ".bc.ktx"))
+        return 1;
+    if (opaque && !Cook(mips, FORMAT_ETC2_RGB, threads, outDir + "/" + name + ".etc2.ktx"))
+        return 1;
+
+    return 0;
+}